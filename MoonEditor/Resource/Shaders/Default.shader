@@ -5,48 +5,56 @@ layout(location = 1) in vec4 aColor;
 layout(location = 2) in vec2 aTexCoord;
 layout(location = 3) in int aTexId;
 layout(location = 4) in vec2 aTiling;
-layout(location = 5) in int aEntityId;
+layout(location = 5) in float aDepth;
 
 out vec4 fColor;
 out vec2 fTexCoord;
 flat out int fTexId;
 flat out vec2 fTiling;
-flat out int fEntityId;
 
-uniform mat4 uVP;
+layout(std140, binding = 0) uniform Frame
+{
+	mat4 uVP;
+	vec2 uViewportSize;
+	float uTime;
+};
 
 void main()
 {
 	gl_Position = uVP * vec4(aPosition, 1.0);
+	//Layer depth replaces the camera depth, sprites are ordered by layer and not by z
+	gl_Position.z = aDepth * gl_Position.w;
 
 	fColor = aColor;
 	fTexCoord = aTexCoord;
 	fTexId = aTexId;
 	fTiling = aTiling;
-	fEntityId = aEntityId;
 }
 
 #Fragment
 #version 450 core
 
 layout(location = 0) out vec4 FragColor;
-layout(location = 1) out int EntityId;
 
 in vec4 fColor;
 in vec2 fTexCoord;
 flat in int fTexId;
 flat in vec2 fTiling;
-flat in int fEntityId;
 
 uniform sampler2D uTexture[32];
+//Above zero in the opaque pass, where blended edges would write depth
+uniform float uAlphaCutoff;
+uniform int uOverdraw;
 
 void main()
 {
 	vec4 color = texture(uTexture[fTexId], fTexCoord * fTiling) * fColor;
 
-	if (color.a == 0.0)
+	if (color.a <= uAlphaCutoff)
 		discard;
 
-	FragColor = color;
-	EntityId = fEntityId;
+	if (uAlphaCutoff > 0.0)
+		color.a = 1.0;
+
+	FragColor = uOverdraw != 0 ? vec4(0.1, 0.05, 0.02, 1.0) : color;
 }
@@ -0,0 +1,67 @@
+#Vertex
+#version 450 core
+layout(location = 0) in vec4 aAxes;
+layout(location = 1) in vec3 aPosition;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in vec4 aTexRect;
+layout(location = 4) in vec2 aTiling;
+layout(location = 5) in int aTexId;
+layout(location = 6) in float aDepth;
+
+out vec4 fColor;
+out vec2 fTexCoord;
+flat out int fTexId;
+flat out vec2 fTiling;
+
+layout(std140, binding = 0) uniform Frame
+{
+	mat4 uVP;
+	vec2 uViewportSize;
+	float uTime;
+};
+
+//Quad corners indexed by the shared quad index buffer (0, 1, 2, 0, 2, 3)
+const vec2 Corners[4] = vec2[4](vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5), vec2(-0.5, 0.5));
+const vec2 CornerTexCoords[4] = vec2[4](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main()
+{
+	vec2 corner = Corners[gl_VertexID];
+	vec3 position = aPosition + vec3(aAxes.xy * corner.x + aAxes.zw * corner.y, 0.0);
+	gl_Position = uVP * vec4(position, 1.0);
+	//Layer depth replaces the camera depth, sprites are ordered by layer and not by z
+	gl_Position.z = aDepth * gl_Position.w;
+
+	fColor = aColor;
+	fTexCoord = mix(aTexRect.xy, aTexRect.zw, CornerTexCoords[gl_VertexID]);
+	fTexId = aTexId;
+	fTiling = aTiling;
+}
+
+#Fragment
+#version 450 core
+
+layout(location = 0) out vec4 FragColor;
+
+in vec4 fColor;
+in vec2 fTexCoord;
+flat in int fTexId;
+flat in vec2 fTiling;
+
+uniform sampler2D uTexture[32];
+//Above zero in the opaque pass, where blended edges would write depth
+uniform float uAlphaCutoff;
+uniform int uOverdraw;
+
+void main()
+{
+	vec4 color = texture(uTexture[fTexId], fTexCoord * fTiling) * fColor;
+
+	if (color.a <= uAlphaCutoff)
+		discard;
+
+	if (uAlphaCutoff > 0.0)
+		color.a = 1.0;
+
+	FragColor = uOverdraw != 0 ? vec4(0.1, 0.05, 0.02, 1.0) : color;
+}
@@ -1,33 +1,53 @@
 #Vertex
 #version 450 core
-layout(location = 0) in vec3 aPosition;
+layout(location = 0) in vec3 aStart;
 layout(location = 1) in vec4 aColor;
-layout(location = 2) in int aEntityId;
+layout(location = 2) in vec3 aEnd;
+layout(location = 3) in float aWidth;
 
 out vec4 fColor;
-flat out int fEntityId;
 
-uniform mat4 uVP;
+layout(std140, binding = 0) uniform Frame
+{
+	mat4 uVP;
+	vec2 uViewportSize;
+	float uTime;
+};
+
+//Quad corners indexed by (0, 1, 2, 0, 2, 3), x picks the end point and y the side of the segment
+const vec2 Corners[4] = vec2[4](vec2(0.0, -0.5), vec2(1.0, -0.5), vec2(1.0, 0.5), vec2(0.0, 0.5));
 
 void main()
 {
-	gl_Position = uVP * vec4(aPosition.x, aPosition.y, aPosition.z, 1.0);
+	vec4 start = uVP * vec4(aStart, 1.0);
+	vec4 end = uVP * vec4(aEnd, 1.0);
+
+	//Widened in pixels so the line keeps its width at any zoom
+	vec2 halfViewport = uViewportSize * 0.5;
+	vec2 direction = (end.xy / end.w - start.xy / start.w) * halfViewport;
+	float segmentLength = length(direction);
+	direction = segmentLength > 0.0001 ? direction / segmentLength : vec2(1.0, 0.0);
+	vec2 normal = vec2(-direction.y, direction.x);
+
+	vec2 corner = Corners[gl_VertexID];
+	vec4 position = corner.x > 0.0 ? end : start;
+
+	//Ends reach half the width past the points so the corners of rects close
+	vec2 offset = normal * corner.y * aWidth + direction * (corner.x - 0.5) * aWidth;
+	position.xy += offset / halfViewport * position.w;
+	gl_Position = position;
 
 	fColor = aColor;
-	fEntityId = aEntityId;
 }
 
 #Fragment
 #version 450 core
 
 layout(location = 0) out vec4 FragColor;
-layout(location = 1) out int EntityId;
 
 in vec4 fColor;
-flat in int fEntityId;
 
 void main()
 {
 	FragColor = fColor;
-	EntityId = fEntityId;
 }
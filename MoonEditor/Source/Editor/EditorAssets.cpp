@@ -1,6 +1,8 @@
 #include "mpch.h"
 #include "EditorAssets.h"
 
+#include <Renderer/TextureLoader.h>
+
 namespace MoonEngine
 {
 	Shared<Texture> EditorAssets::PlayTexture, EditorAssets::StopTexture, EditorAssets::PauseTexture, EditorAssets::SettingsTexture;
@@ -9,18 +11,18 @@ namespace MoonEngine
 
 	void EditorAssets::LoadTextures()
 	{
-		PlayTexture = MakeShared<Texture>("Resource/EditorIcons/Play.png");
-		StopTexture = MakeShared<Texture>("Resource/EditorIcons/Stop.png");
-		PauseTexture = MakeShared<Texture>("Resource/EditorIcons/Pause.png");
-		SettingsTexture = MakeShared<Texture>("Resource/EditorIcons/Settings.png");
+		PlayTexture = TextureLoader::Load("Resource/EditorIcons/Play.png");
+		StopTexture = TextureLoader::Load("Resource/EditorIcons/Stop.png");
+		PauseTexture = TextureLoader::Load("Resource/EditorIcons/Pause.png");
+		SettingsTexture = TextureLoader::Load("Resource/EditorIcons/Settings.png");
 
-		SelectTexture = MakeShared<Texture>("Resource/EditorIcons/Select.png");
-		TranslateTexture = MakeShared<Texture>("Resource/EditorIcons/Translate.png");
-		ResizeTexture = MakeShared<Texture>("Resource/EditorIcons/Resize.png");
-		RotateTexture = MakeShared<Texture>("Resource/EditorIcons/Rotate.png");
-		TransformationTexture = MakeShared<Texture>("Resource/EditorIcons/Transformation.png");
+		SelectTexture = TextureLoader::Load("Resource/EditorIcons/Select.png");
+		TranslateTexture = TextureLoader::Load("Resource/EditorIcons/Translate.png");
+		ResizeTexture = TextureLoader::Load("Resource/EditorIcons/Resize.png");
+		RotateTexture = TextureLoader::Load("Resource/EditorIcons/Rotate.png");
+		TransformationTexture = TextureLoader::Load("Resource/EditorIcons/Transformation.png");
 
-		CameraTexture = MakeShared<Texture>("Resource/EditorIcons/Camera.png");
-		FlareTexture = MakeShared<Texture>("Resource/EditorIcons/Flare.png");
+		CameraTexture = TextureLoader::Load("Resource/EditorIcons/Camera.png");
+		FlareTexture = TextureLoader::Load("Resource/EditorIcons/Flare.png");
 	}
 }
\ No newline at end of file
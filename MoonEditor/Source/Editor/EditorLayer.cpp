@@ -233,6 +233,9 @@ namespace MoonEngine
 			return;
 
 		static bool showDemoWindow = false;
+		static int captureFrames = 60;
+		static int replayLoops = 10;
+		static FrameReplayStats replayStats;
 
 		ImGui::Begin(ICON_MD_BUG_REPORT "Debug", &m_ShowDebug);
 		ImGui::Text("FPS: %.1f FPS (%.2f ms/frame) ", ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
@@ -263,8 +266,68 @@ namespace MoonEngine
 		}
 
 		const auto& renderStats = Renderer::GetStats();
-		ImGui::Text("Viewport Renderer Data");
+		ImGui::Text("Renderer Data (Last Frame)");
 		ImGui::Text("Draw Calls: %d", renderStats.DrawCalls);
+		ImGui::Text("Quads: %d Static: %d Opaque: %d", renderStats.Quads, renderStats.StaticQuads, renderStats.OpaqueQuads);
+		ImGui::Text("Lines: %d", renderStats.Lines);
+		ImGui::Text("Uploaded: %.1f KB", renderStats.UploadBytes / 1024.0f);
+		ImGui::Text("Texture Binds: %d Shader Binds: %d", renderStats.TextureBinds, renderStats.ShaderBinds);
+		ImGui::Text("Flushes Quads: %d Textures: %d", renderStats.Flushes[(size_t)FlushReason::QuadOverflow],
+			renderStats.Flushes[(size_t)FlushReason::TextureSlots]);
+		ImGui::Text("Atlas Pages: %d Textures Loading: %d", renderStats.AtlasPages, TextureLoader::GetPendingCount());
+		ImGui::Text("Render Targets: %d Allocated: %d Grown: %d", renderStats.RenderTargets, renderStats.RenderTargetAllocations, renderStats.RenderTargetReallocations);
+
+		const ShaderCacheStats& shaderStats = Shader::GetCacheStats();
+		ImGui::Text("Shaders Cached: %d Compiled: %d (%.1f ms)", shaderStats.Loaded, shaderStats.Compiled, shaderStats.Time);
+
+		ImGui::PlotLines("##DrawCalls", renderStats.DrawCallHistory, RenderPassStats::HistorySize, renderStats.HistoryOffset, "Draw Calls", 0.0f, FLT_MAX, { 0.0f, 40.0f });
+		for (const auto& pass : renderStats.Passes)
+		{
+			char overlay[64];
+			snprintf(overlay, sizeof(overlay), "%s Gpu: %.2f ms", pass.Name.c_str(), pass.GpuTime);
+			ImGui::PlotLines(("##" + pass.Name).c_str(), pass.GpuTimeHistory, RenderPassStats::HistorySize, renderStats.HistoryOffset, overlay, 0.0f, FLT_MAX, { 0.0f, 40.0f });
+		}
+
+		bool instanced = Renderer::GetRenderMode() == RenderMode::Instanced;
+		if (ImGui::Checkbox("Instanced Quads", &instanced))
+			Renderer::SetRenderMode(instanced ? RenderMode::Instanced : RenderMode::Batched);
+
+		bool overdraw = Renderer::IsOverdrawView();
+		if (ImGui::Checkbox("Overdraw Heatmap", &overdraw))
+			Renderer::SetOverdrawView(overdraw);
+
+		bool threaded = Renderer::IsThreaded();
+		if (ImGui::Checkbox("Render Thread", &threaded))
+			Renderer::SetThreaded(threaded);
+
+		//Compare the write time across thread counts for how the quad writing scales on this machine
+		int writeThreads = (int)Renderer::GetWriteThreads();
+		if (ImGui::SliderInt("Write Threads", &writeThreads, 1, (int)std::max(std::thread::hardware_concurrency(), 1u)))
+			Renderer::SetWriteThreads(writeThreads);
+		ImGui::Text("Quad Writing: %.2f ms", renderStats.WriteTime);
+
+		//Captures land next to the resources so the replay tool finds them from the same working directory
+		const char* capturePath = "Resource/Frames.capture";
+		ImGui::InputInt("Capture Frames", &captureFrames);
+		captureFrames = std::max(captureFrames, 1);
+		ImGui::BeginDisabled(FrameCapture::IsCapturing());
+		if (ImGui::Button("Capture"))
+			FrameCapture::Start(capturePath, (uint32_t)captureFrames);
+		ImGui::EndDisabled();
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+		ImGui::InputInt("##rl", &replayLoops);
+		replayLoops = std::max(replayLoops, 1);
+		ImGui::SameLine();
+		if (ImGui::Button("Replay"))
+			FrameCapture::Replay(capturePath, (uint32_t)replayLoops, replayStats);
+
+		if (replayStats.Frames > 0)
+		{
+			ImGui::Text("Replayed %d frames, Quads: %d Lines: %d Draw Calls: %d", replayStats.Frames, replayStats.Quads, replayStats.Lines, replayStats.DrawCalls);
+			ImGui::Text("Submit: %.2f ms End Frame: %.2f ms Writing: %.2f ms Gpu: %.2f ms", replayStats.SubmitTime, replayStats.EndFrameTime, replayStats.WriteTime, replayStats.GpuTime);
+		}
 		//ImGui::Text("Vertex Count: %d", renderStats.VertexCount);
 		//ImGui::Text("Quad Count: %d", renderStats.QuadCount);
 
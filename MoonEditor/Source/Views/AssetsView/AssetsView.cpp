@@ -3,6 +3,7 @@
 #include "Editor/EditorAssets.h"
 
 #include <Renderer/Texture.h>
+#include <Renderer/TextureLoader.h>
 #include <Gui/ImGuiUtils.h>
 
 #include <IconsMaterialDesign.h>
@@ -90,8 +91,8 @@ namespace MoonEngine
 		Name = ICON_MD_TOKEN;
 		Name += "Assets";
 
-		m_FileIcon = MakeShared<Texture>("Resource/EditorIcons/File.png");
-		m_FolderIcon = MakeShared<Texture>("Resource/EditorIcons/Folder.png");
+		m_FileIcon = TextureLoader::Load("Resource/EditorIcons/File.png");
+		m_FolderIcon = TextureLoader::Load("Resource/EditorIcons/Folder.png");
 
 		m_StartPath = startPath;
 		m_CurrentPath = m_StartPath;
@@ -2,7 +2,9 @@
 #include "GameView.h"
 #include "Editor/EditorLayer.h"
 
+#include <Core/Time.h>
 #include <Engine/Components.h>
+#include <Gui/ImGuiUtils.h>
 
 #include <IconsMaterialDesign.h>
 
@@ -15,7 +17,8 @@ namespace MoonEngine
 		Flags = ImGuiWindowFlags_::ImGuiWindowFlags_NoScrollbar;
 		Enabled = false;
 
-		FramebufferProps props = { {FramebufferTextureFormat::RGBA8}, {FramebufferTextureFormat::DEPTH} };
+		//Only the colour outlives the frame, the depth is a transient of the render graph
+		FramebufferProps props = { {FramebufferTextureFormat::RGBA8} };
 		m_Gamebuffer = MakeShared<Framebuffer>(props);
 	}
 
@@ -26,10 +29,18 @@ namespace MoonEngine
 
 		auto& registry = GetRegistry();
 
+		//Only the game pass gets cheaper with the scale, so its gpu time drives it
+		float gpuTime = 0.0f;
+		for (const auto& pass : Renderer::GetStats().Passes)
+			if (pass.Name == "Game")
+				gpuTime = pass.GpuTime;
+		m_Resolution.Update(Time::CpuTime() * 1000.0f, gpuTime);
+
 		const auto& viewportSize = ViewSize;
-		if (viewportSize.x != m_Gamebuffer->GetWidth() || viewportSize.y != m_Gamebuffer->GetHeight())
+		glm::uvec2 renderSize = m_Resolution.GetRenderSize(viewportSize);
+		if (renderSize.x != m_Gamebuffer->GetWidth() || renderSize.y != m_Gamebuffer->GetHeight())
 		{
-			m_Gamebuffer->Resize((uint32_t)viewportSize.x, (uint32_t)viewportSize.y);
+			m_Gamebuffer->Resize(renderSize.x, renderSize.y);
 		}
 
 		CameraComponent* sceneCamera = nullptr;
@@ -48,7 +59,7 @@ namespace MoonEngine
 			}
 		});
 
-		glm::mat4 viewProjection;
+		glm::mat4 viewProjection = glm::mat4(1.0f);
 		if (sceneCamera)
 		{
 			sceneCamera->Resize(viewportSize.x / viewportSize.y);
@@ -58,27 +69,48 @@ namespace MoonEngine
 		}
 
 		//+Render Game
-		m_Gamebuffer->Bind();
+		uint32_t width = m_Gamebuffer->GetWidth();
+		uint32_t height = m_Gamebuffer->GetHeight();
+
+		RenderGraphTexture color = m_RenderGraph.Import("Game", m_Gamebuffer->GetTexID(), FramebufferTextureFormat::RGBA8, width, height);
+		RenderGraphTexture depth = m_RenderGraph.Create("Game Depth", FramebufferTextureFormat::DEPTH, width, height);
+
+		m_RenderGraph.AddPass("Game", [&](RenderGraph::PassBuilder& pass)
+		{
+			pass.Write(color);
+			pass.Write(depth);
+		}, [&] { RenderScene(viewProjection); });
+
+		m_RenderGraph.Execute();
+		//-Render Game
+	}
+
+	void GameView::RenderScene(const glm::mat4& viewProjection)
+	{
+		auto& registry = GetRegistry();
 
 		Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f });
-		Renderer::Begin(viewProjection);
+		Renderer::Begin(viewProjection, "Game");
+
+		glm::vec2 viewMin, viewMax;
+		Scene::GetViewBounds(viewProjection, viewMin, viewMax);
 
 		//SpriteRenderer
 		{
-			auto view = registry.view<const TransformComponent, const SpriteComponent>();
-			for (auto [entity, transform, sprite] : view.each())
-				Renderer::DrawEntity(transform, sprite, (int)entity);
+			Renderer::DrawStaticBatch(Scene->GetStaticSprites(), viewMin, viewMax);
+			for (auto [entity, transform, tilemap] : registry.view<const TransformComponent, TilemapComponent>().each())
+				Renderer::DrawTilemap(transform, tilemap, viewMin, viewMax);
+			Renderer::DrawSprites(Scene->QueryVisibleSprites(viewProjection));
 		}
 
 		//ParticleSystem
 		{
 			auto view = registry.view<ParticleComponent>();
 			for (auto [entity, particle] : view.each())
-				particle.ParticleSystem.DrawParticles((int)entity);
+				particle.ParticleSystem.DrawParticles(viewMin, viewMax);
 		}
 
 		Renderer::End();
-		m_Gamebuffer->Unbind();
 	}
 
 	void GameView::Render()
@@ -92,7 +124,37 @@ namespace MoonEngine
 
 		OnWindowBegin();
 
-		ImGui::Image((void*)m_Gamebuffer->GetTexID(), { ViewSize.x, ViewSize.y }, { 0, 1 }, { 1, 0 });
+		//Scaled targets are stretched over the view, the half texel inset keeps the filter off the unused part of the attachment
+		glm::vec2 texCoordMin = glm::vec2(0.0f);
+		glm::vec2 texCoordMax = m_Gamebuffer->GetTexCoordMax();
+		if (m_Resolution.GetScale() < 1.0f)
+		{
+			glm::vec2 halfTexel = texCoordMax / glm::vec2(m_Gamebuffer->GetWidth(), m_Gamebuffer->GetHeight()) * 0.5f;
+			texCoordMin += halfTexel;
+			texCoordMax -= halfTexel;
+		}
+		ImGui::Image((void*)m_Gamebuffer->GetTexID(), { ViewSize.x, ViewSize.y }, { texCoordMin.x, texCoordMax.y }, { texCoordMax.x, texCoordMin.y });
+
+		if (ImGui::BeginPopupContextItem("GameSettingsPopup"))
+		{
+			ImGuiUtils::Label("Dynamic Resolution: ");
+			ImGui::Checkbox("##dr", &m_Resolution.Enabled);
+
+			ImGuiUtils::Label("Target Frame Time: ");
+			ImGui::DragFloat("##tft", &m_Resolution.TargetFrameTime, 0.1f, 1.0f, 100.0f, "%.1f ms", ImGuiSliderFlags_AlwaysClamp);
+
+			ImGuiUtils::Label("Min Scale: ");
+			ImGui::SliderFloat("##mis", &m_Resolution.MinScale, 0.1f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+
+			ImGuiUtils::Label("Max Scale: ");
+			ImGui::SliderFloat("##mas", &m_Resolution.MaxScale, m_Resolution.MinScale, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
+
+			ImGui::Text("Rendering at %.0f%% (%dx%d)", m_Resolution.GetScale() * 100.0f, m_Gamebuffer->GetWidth(), m_Gamebuffer->GetHeight());
+			//A cpu over the target is not helped by the scale
+			ImGui::Text("Cpu %.2f ms, Gpu %.2f ms", m_Resolution.GetCpuTime(), m_Resolution.GetGpuTime());
+
+			ImGui::EndPopup();
+		}
 
 		ImGui::End();
 		ImGui::PopStyleVar();
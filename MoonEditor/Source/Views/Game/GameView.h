@@ -12,5 +12,10 @@ namespace MoonEngine
 		void Render();
 
 		Shared<Framebuffer> m_Gamebuffer;
+		DynamicResolution m_Resolution;
+	private:
+		RenderGraph m_RenderGraph;
+
+		void RenderScene(const glm::mat4& viewProjection);
 	};
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Editor/EditorLayer.h"
 
 #include <Engine/Components.h>
+#include <Renderer/TextureLoader.h>
 #include <Gui/ImGuiUtils.h>
 #include <Scripting/ScriptEngine.h>
 
@@ -337,6 +338,11 @@ namespace MoonEngine
 		ImGui::PopID();
 	}
 
+	static bool HasChanged(const TransformComponent& before, const TransformComponent& after)
+	{
+		return before.Position != after.Position || before.Rotation != after.Rotation || before.Scale != after.Scale;
+	}
+
 	void RenderTransformComponent(Entity selectedEntity)
 	{
 		ImGui::PushID("Transform");
@@ -349,12 +355,19 @@ namespace MoonEngine
 			ImGuiUtils::AddPadding(0.0f, 10.0f);
 
 			TransformComponent& component = selectedEntity.GetComponent<TransformComponent>();
-			glm::vec3& position = component.Position;
+			TransformComponent before = component;
 			UtilVectorColumn("Position", component.Position);
 			UtilVectorColumn("Size", component.Scale, 1.0f);
-			glm::vec3 rotation = glm::degrees(component.Rotation);
-			UtilVectorColumn("Rotation", rotation);
-			component.Rotation = glm::radians(rotation);
+			//Converting back every frame would not round trip exactly and patch an untouched transform
+			const glm::vec3& rotation = glm::degrees(component.Rotation);
+			glm::vec3 editedRotation = rotation;
+			UtilVectorColumn("Rotation", editedRotation);
+			if (editedRotation != rotation)
+				component.Rotation = glm::radians(editedRotation);
+
+			//The spatial grid and static chunks only see patched transforms
+			if (HasChanged(before, component))
+				selectedEntity.PatchComponent<TransformComponent>();
 
 			ImGuiUtils::AddPadding(0.0f, 10.0f);
 			ImGui::Separator();
@@ -363,6 +376,20 @@ namespace MoonEngine
 		ImGui::PopID();
 	}
 
+	//Static sprites are rebuilt from registry update signals, edits made here have to be reported
+	static bool HasChanged(const SpriteComponent& before, const SpriteComponent& after)
+	{
+		return before.Color != after.Color || before.Tiling != after.Tiling || before.Layer != after.Layer || before.Static != after.Static
+			|| before.SpriteCoords != after.SpriteCoords || before.SpriteSize != after.SpriteSize
+			|| before.GetTexture() != after.GetTexture() || before.GetTextureSheet() != after.GetTextureSheet();
+	}
+
+	static bool HasChanged(const SpriteAnimationComponent& before, const SpriteAnimationComponent& after)
+	{
+		return before.CellSize != after.CellSize || before.FirstCell != after.FirstCell || before.FrameCount != after.FrameCount
+			|| before.FramesPerSecond != after.FramesPerSecond || before.LoopMode != after.LoopMode || before.Speed != after.Speed || before.Playing != after.Playing;
+	}
+
 	template<typename T>
 	void ShowComponent(const std::string& componentName, std::function<void(T&)> function, Entity selectedEntity)
 	{
@@ -396,7 +423,15 @@ namespace MoonEngine
 			if (treeopen)
 			{
 				ImGuiUtils::AddPadding(0.0f, 10.0f);
-				function(component);
+				if constexpr (std::is_same_v<T, TransformComponent> || std::is_same_v<T, SpriteComponent> || std::is_same_v<T, SpriteAnimationComponent>)
+				{
+					T before = component;
+					function(component);
+					if (selectedEntity.HasComponent<T>() && HasChanged(before, component))
+						selectedEntity.PatchComponent<T>();
+				}
+				else
+					function(component);
 				ImGuiUtils::AddPadding(0.0f, 20.0f);
 				ImGui::TreePop();
 			}
@@ -445,6 +480,11 @@ namespace MoonEngine
 
 			});
 
+			RenderProp("Static", [&]
+			{
+				ImGui::Checkbox("##Static", &component.Static);
+			});
+
 			bool hasSpriteSheet = component.GetTextureSheet() != nullptr;
 			RenderProp("Texture", [&]
 			{
@@ -472,7 +512,7 @@ namespace MoonEngine
 					{
 						const wchar_t* path = (const wchar_t*)payload->Data;
 						std::filesystem::path texturePath = path;
-						Shared<Texture> texture = MakeShared<Texture>(texturePath.string());
+						Shared<Texture> texture = TextureLoader::Load(texturePath.string());
 						if (texture)
 						{
 							component.SetTexture(texture);
@@ -514,6 +554,136 @@ namespace MoonEngine
 
 		}, selectedEntity);
 
+		ShowComponent<SpriteAnimationComponent>("Sprite Animation", [&](SpriteAnimationComponent& component)
+		{
+			BeginDrawProp("##SpriteAnimation");
+
+			RenderProp("Cell Size", [&]
+			{
+				ImGui::DragFloat2("##CellSize", &component.CellSize[0], dragSliderSpeed, 1.0f, FLT_MAX, "%.0f");
+			});
+
+			RenderProp("First Cell", [&]
+			{
+				ImGui::DragFloat2("##FirstCell", &component.FirstCell[0], dragSliderSpeed, 0.0f, FLT_MAX, "%.0f");
+			});
+
+			RenderProp("Frame Count", [&]
+			{
+				ImGui::DragInt("##FrameCount", &component.FrameCount, dragSliderSpeed, 1, INT_MAX, "%d", ImGuiSliderFlags_AlwaysClamp);
+			});
+
+			RenderProp("Frames Per Second", [&]
+			{
+				ImGui::DragFloat("##FramesPerSecond", &component.FramesPerSecond, dragSliderSpeed, 0.0f, FLT_MAX, "%.2f");
+			});
+
+			RenderProp("Loop Mode", [&]
+			{
+				int loopMode = (int)component.LoopMode;
+				if (ImGui::Combo("##LoopMode", &loopMode, "Once\0Loop\0Ping Pong\0"))
+					component.LoopMode = (AnimationLoopMode)loopMode;
+			});
+
+			RenderProp("Speed", [&]
+			{
+				ImGui::DragFloat("##Speed", &component.Speed, dragSliderSpeed, 0.0f, FLT_MAX, "%.2f");
+			});
+
+			RenderProp("Playing", [&]
+			{
+				ImGui::Checkbox("##Playing", &component.Playing);
+			});
+
+			EndDrawProp();
+		}, selectedEntity);
+
+		ShowComponent<TilemapComponent>("Tilemap", [&](TilemapComponent& component)
+		{
+			BeginDrawProp("##Tilemap");
+
+			RenderProp("Tileset", [&]
+			{
+				if (component.Tileset)
+				{
+					if (ImGui::Button(" X "))
+						component.Tileset = nullptr;
+					else
+					{
+						ImGui::SameLine();
+						ImGui::Text(component.Tileset->GetPath().filename().string().c_str());
+					}
+				}
+				else
+					ImGui::Text("None");
+
+				if (ImGui::BeginDragDropTarget())
+				{
+					if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("ME_AssetItem"))
+					{
+						std::filesystem::path texturePath = (const wchar_t*)payload->Data;
+						if (Shared<Texture> texture = TextureLoader::Load(texturePath.string()))
+							component.Tileset = texture;
+						else
+							ME_ERR("Failed to load Texture! Path: {}", texturePath.string().c_str());
+					}
+					ImGui::EndDragDropTarget();
+				}
+			});
+
+			RenderProp("Tile Size", [&]
+			{
+				ImGui::DragFloat2("##TileSize", &component.TileSize[0], dragSliderSpeed, 1.0f, FLT_MAX, "%.0f");
+			});
+
+			RenderProp("Color", [&]
+			{
+				ImGui::ColorEdit4("##Color", &component.Color[0]);
+			});
+
+			RenderProp("Layer", [&]
+			{
+				ImGui::DragInt("##Layer", &component.Layer, dragSliderSpeed, 0, Renderer::GetStats().MaxLayers - 1, "%d", ImGuiSliderFlags_AlwaysClamp);
+			});
+
+			EndDrawProp();
+
+			ImGui::Text("Tiles: %d Chunks: %d", component.Tiles.GetTileCount(), component.Tiles.GetChunkCount());
+
+			//Rectangle fill until the viewport gets a tile brush
+			static glm::ivec2 fillMin = glm::ivec2(0);
+			static glm::ivec2 fillMax = glm::ivec2(0);
+			static int fillTile = 0;
+
+			DrawTreeProp("Fill", [&]
+			{
+				RenderProp("Min Cell", [&]
+				{
+					ImGui::DragInt2("##FillMin", &fillMin[0], dragSliderSpeed);
+				});
+
+				RenderProp("Max Cell", [&]
+				{
+					ImGui::DragInt2("##FillMax", &fillMax[0], dragSliderSpeed);
+				});
+
+				RenderProp("Tile", [&]
+				{
+					ImGui::DragInt("##FillTile", &fillTile, dragSliderSpeed, 0, UINT16_MAX - 1, "%d", ImGuiSliderFlags_AlwaysClamp);
+				});
+
+				RenderProp("Apply", [&]
+				{
+					if (ImGui::Button("Fill"))
+						component.Tiles.Fill(fillMin, fillMax, fillTile);
+
+					ImGui::SameLine();
+					if (ImGui::Button("Erase"))
+						component.Tiles.Fill(fillMin, fillMax, -1);
+				});
+			});
+		}, selectedEntity);
+
 		ShowComponent<ScriptComponent>("Script", [&](ScriptComponent& component)
 		{
 			bool isEditorPlaying = EditorLayer::State() != EditorLayer::EditorState::Edit;
@@ -935,7 +1105,7 @@ namespace MoonEngine
 						{
 							const wchar_t* path = (const wchar_t*)payload->Data;
 							std::filesystem::path texturePath = path;
-							Shared<Texture> texture = MakeShared<Texture>(texturePath.string());
+							Shared<Texture> texture = TextureLoader::Load(texturePath.string());
 							if (texture)
 								component.Particle.Texture = texture;
 							else
@@ -1029,6 +1199,14 @@ namespace MoonEngine
 						if (!selectedEntity.HasComponent<SpriteComponent>())
 							selectedEntity.AddComponent<SpriteComponent>();
 
+					if (ImGui::MenuItem("Sprite Animation"))
+						if (!selectedEntity.HasComponent<SpriteAnimationComponent>())
+							selectedEntity.AddComponent<SpriteAnimationComponent>();
+
+					if (ImGui::MenuItem("Tilemap"))
+						if (!selectedEntity.HasComponent<TilemapComponent>())
+							selectedEntity.AddComponent<TilemapComponent>();
+
 					if (ImGui::MenuItem("Script"))
 						if (!selectedEntity.HasComponent<ScriptComponent>())
 							selectedEntity.AddComponent<ScriptComponent>();
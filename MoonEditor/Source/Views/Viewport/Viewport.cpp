@@ -6,6 +6,7 @@
 #include <Core/Time.h>
 #include <Engine/Components.h>
 #include <Engine/Entity.h>
+#include <Renderer/DebugRenderer.h>
 #include <Utils/Maths.h>
 #include <Gui/ImGuiUtils.h>
 
@@ -25,7 +26,8 @@ namespace MoonEngine
 		m_GizmosData.ShowGizmos = true;
 		m_GizmosData.GizmosColor = { 0.0f, 0.6f, 1.0f, 1.0f };
 
-		FramebufferProps props = { {FramebufferTextureFormat::RGBA8}, {FramebufferTextureFormat::RED_INTEGER}, {FramebufferTextureFormat::DEPTH} };
+		//Only the colour outlives the frame, the depth is a transient of the render graph
+		FramebufferProps props = { {FramebufferTextureFormat::RGBA8} };
 		Viewbuffer = MakeShared<Framebuffer>(props);
 		m_EditorCamera = MakeShared<EditorCamera>();
 		m_EditorCamera->Zoom(2.5f);
@@ -36,7 +38,6 @@ namespace MoonEngine
 		if (!Enabled)
 			return;
 
-		auto& registry = GetRegistry();
 		auto& selectedEntity = EditorLayer::Get()->GetSelectedEntity();
 
 		const auto& viewportSize = ViewSize;
@@ -51,18 +52,65 @@ namespace MoonEngine
 		m_GizmosData.IsSnapping = Input::GetKey(Keycode::LeftControl);
 
 		//+Render Viewport
-		Viewbuffer->Bind();
+		const glm::mat4& viewProjection = m_EditorCamera->GetViewProjection();
+		uint32_t width = Viewbuffer->GetWidth();
+		uint32_t height = Viewbuffer->GetHeight();
+
+		//Depth only lives through the scene pass, the game view gets the same texture after it
+		RenderGraphTexture color = m_RenderGraph.Import("Viewport", Viewbuffer->GetTexID(), FramebufferTextureFormat::RGBA8, width, height);
+		RenderGraphTexture depth = m_RenderGraph.Create("Viewport Depth", FramebufferTextureFormat::DEPTH, width, height);
+
+		m_RenderGraph.AddPass("Viewport", [&](RenderGraph::PassBuilder& pass)
+		{
+			pass.Write(color);
+			pass.Write(depth);
+		}, [&] { RenderScene(viewProjection); });
+
+		//Icons and outlines stay on top of the scene, so the pass leaves the depth out
+		m_RenderGraph.AddPass("Gizmos", [&](RenderGraph::PassBuilder& pass) { pass.Write(color); }, [&] { RenderGizmos(viewProjection); });
+
+		m_RenderGraph.Execute();
+		//-Render Viewport
+
+		//+MousePicking
+		if (ViewHovered)
+		{
+			const auto& viewportPositon = ViewPosition;
+			ImVec2 mousePos = ImGui::GetMousePos();
+			mousePos.x -= viewportPositon.x;
+			mousePos.y -= viewportPositon.y;
+			mousePos.y = viewportSize.y - mousePos.y;
+
+			int mouseX = (int)mousePos.x;
+			int mouseY = (int)mousePos.y;
+
+			if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && (int)mouseY < viewportSize.y && Input::GetMouseButtonDown(0) && !m_GizmosData.IsUsing)
+			{
+				glm::vec2 point = { mousePos.x / viewportSize.x * 2.0f - 1.0f, mousePos.y / viewportSize.y * 2.0f - 1.0f };
+				selectedEntity = PickEntity(viewProjection, point);
+			}
+		}
+		//-MousePicking
+	}
+
+	void ViewportView::RenderScene(const glm::mat4& viewProjection)
+	{
+		auto& registry = GetRegistry();
+		auto& selectedEntity = EditorLayer::Get()->GetSelectedEntity();
 
 		Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f });
-		Renderer::Begin(m_EditorCamera->GetViewProjection());
-		Viewbuffer->ClearColorAttachment(1, (void*)-1);
+		Renderer::Begin(viewProjection, "Viewport");
+
+		glm::vec2 viewMin, viewMax;
+		Scene::GetViewBounds(viewProjection, viewMin, viewMax);
 
 		//SpriteRenderer
-		auto view = registry.view<const TransformComponent, const SpriteComponent>();
-		for (auto [entity, transform, sprite] : view.each())
-			Renderer::DrawEntity(transform, sprite, (int)entity);
+		Renderer::DrawStaticBatch(Scene->GetStaticSprites(), viewMin, viewMax);
+		for (auto [entity, transform, tilemap] : registry.view<const TransformComponent, TilemapComponent>().each())
+			Renderer::DrawTilemap(transform, tilemap, viewMin, viewMax);
+		Renderer::DrawSprites(Scene->QueryVisibleSprites(viewProjection));
 
-		Renderer::SetLineWidth(2.0f);
+		DebugRenderer::SetLineWidth(2.0f);
 
 		//ParticleSystem
 		auto particleSystemView = registry.view<const TransformComponent, ParticleComponent>();
@@ -87,36 +135,35 @@ namespace MoonEngine
 				{
 					case EmitterType::Box:
 					{
-						Renderer::DrawRect(transformComponent.Position + particle.Particle.SpawnPosition, particle.Particle.SpawnRadius,
-										   m_GizmosData.GizmosColor, (int)entity);
+						DebugRenderer::DrawRect(transformComponent.Position + particle.Particle.SpawnPosition, particle.Particle.SpawnRadius,
+												m_GizmosData.GizmosColor);
 						break;
 					}
 					case EmitterType::Cone:
 					{
-						int ent = (int)entity;
 						const auto& color = m_GizmosData.GizmosColor;
 
 						const glm::vec3& spawnPos = transformComponent.Position + particle.Particle.SpawnPosition;
 						const glm::vec3& tipPos = spawnPos + glm::vec3(0.0f, particle.Particle.SpawnRadius.y, 0.0f);
 
-						Renderer::DrawLine(spawnPos, tipPos, color, ent);
+						DebugRenderer::DrawLine(spawnPos, tipPos, color);
 
 						float spawnRadiusX = particle.Particle.SpawnRadius.x * 0.5f;
 						const glm::vec3& spawnRadius = glm::vec3(spawnRadiusX, 0.0f, 0.0f);
 
 						const glm::vec3& p0 = spawnPos - spawnRadius;
 						const glm::vec3& p1 = spawnPos + spawnRadius;
-						Renderer::DrawLine(p0, p1, color, ent);
+						DebugRenderer::DrawLine(p0, p1, color);
 
 						float coneRadiusSize = particle.Particle.DirectionRadiusFactor * 0.5f;
 						const glm::vec3& coneRadius = glm::vec3(coneRadiusSize, 0.0f, 0.0f);
 
 						const glm::vec3& p3 = tipPos - spawnRadius - coneRadius;
 						const glm::vec3& p4 = tipPos + spawnRadius + coneRadius;
-						Renderer::DrawLine(p3, p4, color, ent);
+						DebugRenderer::DrawLine(p3, p4, color);
 
-						Renderer::DrawLine(p0, p3, color, ent);
-						Renderer::DrawLine(p1, p4, color, ent);
+						DebugRenderer::DrawLine(p0, p3, color);
+						DebugRenderer::DrawLine(p1, p4, color);
 					}
 					default:
 						break;
@@ -128,14 +175,22 @@ namespace MoonEngine
 					particle.ParticleSystem.Pause();
 			}
 
-			particle.ParticleSystem.DrawParticles((int)entity);
+			particle.ParticleSystem.DrawParticles(viewMin, viewMax);
 		}
 
 		Renderer::End();
+	}
+
+	void ViewportView::RenderGizmos(const glm::mat4& viewProjection)
+	{
+		auto& registry = GetRegistry();
+		auto& selectedEntity = EditorLayer::Get()->GetSelectedEntity();
+
+		Renderer::Begin(viewProjection, "Gizmos", false);
 
 		if (m_GizmosData.ShowGizmos)
 		{
-			Renderer::SetLineWidth(m_GizmosData.LineWidth);
+			DebugRenderer::SetLineWidth(m_GizmosData.LineWidth);
 
 			//GIZMO_CameraComponent
 			auto cameraView = registry.view<const TransformComponent, const CameraComponent>();
@@ -144,7 +199,7 @@ namespace MoonEngine
 				const glm::mat4& transform = glm::translate(glm::mat4(1.0f), transformComponent.Position)
 					* glm::scale(glm::mat4(1.0f), glm::vec3(m_GizmosData.IconSize, m_GizmosData.IconSize, 0.0f));
 
-				Renderer::DrawEntity(transform, { 1.0f, 1.0f, 1.0f, 1.0f }, EditorAssets::CameraTexture, 0, { 1.0f, 1.0f }, (int)entity);
+				Renderer::DrawEntity(transform, { 1.0f, 1.0f, 1.0f, 1.0f }, EditorAssets::CameraTexture, 0, { 1.0f, 1.0f });
 			}
 
 			//GIZMO_ParticleSystem
@@ -156,7 +211,7 @@ namespace MoonEngine
 					const glm::mat4& rotationMat = glm::toMat4(glm::quat(transformComponent.Rotation));
 					glm::mat4 transform = glm::translate(glm::mat4(1.0f), transformComponent.Position)
 						* glm::scale(glm::mat4(1.0f), glm::vec3(m_GizmosData.IconSize, m_GizmosData.IconSize, 0.0f));;
-					Renderer::DrawEntity(transform, { 1.0f, 1.0f, 1.0f, 1.0f }, EditorAssets::FlareTexture, 0, { 1.0f, 1.0f }, (int)entity);
+					Renderer::DrawEntity(transform, { 1.0f, 1.0f, 1.0f, 1.0f }, EditorAssets::FlareTexture, 0, { 1.0f, 1.0f });
 				}
 			}
 
@@ -174,7 +229,7 @@ namespace MoonEngine
 						glm::translate(glm::mat4(1.0f), transformComponent.Position + glm::vec3(pbComponent.Offset, 0.0f))
 						* rotationMat * glm::scale(glm::mat4(1.0f), scale);
 
-					Renderer::DrawRect(transform, { 0.5f, 0.9f, 0.5f, 1.0f });
+					DebugRenderer::DrawRect(transform, { 0.5f, 0.9f, 0.5f, 1.0f });
 				}
 			}
 
@@ -189,7 +244,7 @@ namespace MoonEngine
 					* rotationMat * glm::scale(glm::mat4(1.0f), transformComponent.Scale);
 
 				if (m_GizmosData.HighlightSelected && !selectedEntity.HasComponent<CameraComponent>() && !selectedEntity.HasComponent<ParticleComponent>())
-					Renderer::DrawRect(transform, m_GizmosData.GizmosColor);
+					DebugRenderer::DrawRect(transform, m_GizmosData.GizmosColor);
 
 				if (selectedEntity.HasComponent<PhysicsBodyComponent>())
 				{
@@ -208,37 +263,46 @@ namespace MoonEngine
 						glm::translate(glm::mat4(1.0f), position)
 						* rotationMat * glm::scale(glm::mat4(1.0f), scale);
 
-					Renderer::DrawRect(transform, { 0.0f, 1.0f, 0.0f, 1.0f });
+					DebugRenderer::DrawRect(transform, { 0.0f, 1.0f, 0.0f, 1.0f });
 				}
 			}
-
-			Renderer::End();
 		}
 
-		//+MousePicking
-		if (ViewHovered)
+		DebugRenderer::Flush(viewProjection);
+	}
+
+	Entity ViewportView::PickEntity(const glm::mat4& viewProjection, const glm::vec2& point)
+	{
+		//Gizmo icons are drawn over the scene, so they win over the sprites under them
+		if (m_GizmosData.ShowGizmos)
 		{
-			const auto& viewportPositon = ViewPosition;
-			ImVec2 mousePos = ImGui::GetMousePos();
-			mousePos.x -= viewportPositon.x;
-			mousePos.y -= viewportPositon.y;
-			mousePos.y = viewportSize.y - mousePos.y;
+			glm::vec4 world = glm::inverse(viewProjection) * glm::vec4(point, 0.0f, 1.0f);
+			glm::vec2 position = glm::vec2(world) / world.w;
+			glm::vec2 iconExtents = glm::vec2(m_GizmosData.IconSize * 0.5f);
 
-			int mouseX = (int)mousePos.x;
-			int mouseY = (int)mousePos.y;
+			auto hitRect = [&](const glm::vec3& center, const glm::vec2& extents)
+			{
+				return glm::all(glm::lessThanEqual(glm::abs(position - glm::vec2(center)), extents));
+			};
 
-			if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && (int)mouseY < viewportSize.y && Input::GetMouseButtonDown(0))
+			auto& registry = GetRegistry();
+			for (auto [entity, transformComponent, cameraComponent] : registry.view<const TransformComponent, const CameraComponent>().each())
 			{
-				int pixelData = Viewbuffer->ReadPixel(1, mouseX, mouseY);
-				if (!m_GizmosData.IsUsing)
-					selectedEntity = pixelData == -1 ? Entity{} : Entity{ (entt::entity)pixelData, Scene };
+				if (hitRect(transformComponent.Position, iconExtents))
+					return Entity{ entity, Scene };
 			}
-		}
-		//-MousePicking
 
+			//Running emitters hide their icon, their spawn area is picked instead
+			for (auto [entity, transformComponent, particle] : registry.view<const TransformComponent, ParticleComponent>().each())
+			{
+				bool showsIcon = !particle.ParticleSystem.IsPlaying() && !particle.ParticleSystem.IsPaused();
+				if (showsIcon ? hitRect(transformComponent.Position, iconExtents) :
+					hitRect(transformComponent.Position + particle.Particle.SpawnPosition, glm::vec2(particle.Particle.SpawnRadius) * 0.5f))
+					return Entity{ entity, Scene };
+			}
+		}
 
-		Viewbuffer->Unbind();
-		//-Render Viewport
+		return Scene->PickSprite(viewProjection, point);
 	}
 
 	void ViewportView::Render()
@@ -331,7 +395,8 @@ namespace MoonEngine
 
 		OnWindowBegin();
 
-		ImGui::Image((void*)Viewbuffer->GetTexID(), { ViewSize.x, ViewSize.y }, { 0, 1 }, { 1, 0 });
+		glm::vec2 texCoordMax = Viewbuffer->GetTexCoordMax();
+		ImGui::Image((void*)Viewbuffer->GetTexID(), { ViewSize.x, ViewSize.y }, { 0, texCoordMax.y }, { texCoordMax.x, 0 });
 
 		auto& GizmoSelection = m_GizmosData.GizmoSelection;
 		if (selectedEntity && GizmoSelection != GizmoSelection::NONE)
@@ -365,6 +430,7 @@ namespace MoonEngine
 				component.Position = finalPos;
 				component.Rotation += deltaRotation;
 				component.Scale = finalSiz;
+				selectedEntity.PatchComponent<TransformComponent>();
 				m_GizmosData.IsUsing = true;
 			}
 			else
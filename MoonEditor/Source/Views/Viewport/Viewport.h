@@ -19,5 +19,10 @@ namespace MoonEngine
 	private:
 		Shared<EditorCamera> m_EditorCamera;
 		GizmosData m_GizmosData;
+		RenderGraph m_RenderGraph;
+
+		void RenderScene(const glm::mat4& viewProjection);
+		void RenderGizmos(const glm::mat4& viewProjection);
+		Entity PickEntity(const glm::mat4& viewProjection, const glm::vec2& point);
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
+#include <Renderer/DynamicResolution.h>
 #include <Renderer/Framebuffer.h>
+#include <Renderer/RenderGraph.h>
 #include <Engine/Scene.h>
 #include <imgui.h>
 
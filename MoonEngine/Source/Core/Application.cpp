@@ -6,12 +6,15 @@
 #include "Core/Time.h"
 
 #include "Renderer/Renderer.h"
+#include "Renderer/Shader.h"
 #include "Scripting/ScriptEngine.h"
 
 #include <GLFW/glfw3.h>
 #include <yaml-cpp/yaml.h>
 #include <yaml-cpp/dll.h>
 
+#include <chrono>
+
 namespace MoonEngine
 {
 	Application* Application::s_Instance;
@@ -43,8 +46,10 @@ namespace MoonEngine
 		}
 		ME_SYS_SUC("Window Created...");
 
+		auto rendererStart = std::chrono::steady_clock::now();
 		Renderer::Init();
-		ME_SYS_SUC("Renderer Initialized...");
+		const ShaderCacheStats& shaderStats = Shader::GetCacheStats();
+		ME_SYS_SUC("Renderer Initialized in {0:.1f} ms, shaders: {1} cached {2} compiled...", std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - rendererStart).count(), shaderStats.Loaded, shaderStats.Compiled);
 
 		ScriptEngine::Init();
 		ME_SYS_SUC("Script Engine Initialized...");
@@ -93,7 +98,12 @@ namespace MoonEngine
 			m_ImGuiLayer->BeginDrawGUI();
 			for (auto& layer : m_ApplicationLayers)
 				layer->DrawGui();
+
+			//The last scene packet was prepared while the gui was built, it has to be drawn before the gui samples its target.
+			//Keeping it for the next frame would show every panel a frame late and hold pooled targets across frames
+			Renderer::EndFrame();
 			m_ImGuiLayer->EndDrawGUI();
+			time.CalculateCpu((float)glfwGetTime());
 
 			Input::Update();
 			m_Window->Update();
@@ -6,8 +6,11 @@ namespace MoonEngine
 	{
 	public:
 		static float DeltaTime() { return s_DeltaTime; }
+		//Seconds the last frame spent before presenting, without the swap and vsync wait
+		static float CpuTime() { return s_CpuTime; }
 	private:
 		inline static float s_DeltaTime;
+		inline static float s_CpuTime;
 		float m_LastTime;
 
 		//Function controlled by the Application
@@ -16,6 +19,10 @@ namespace MoonEngine
 			s_DeltaTime = time - m_LastTime;
 			m_LastTime = time;
 		}
+		void CalculateCpu(float time)
+		{
+			s_CpuTime = time - m_LastTime;
+		}
 		//-
 		friend class Application;
 	};
@@ -5,8 +5,10 @@
 #include "Engine/UUID.h"
 
 #include "Renderer/Camera.h"
+#include "Renderer/SpriteAnimation.h"
 #include "Renderer/Texture.h"
 #include "Renderer/TextureSheet.h"
+#include "Renderer/Tilemap.h"
 
 namespace MoonEngine
 {
@@ -37,8 +39,13 @@ namespace MoonEngine
 		glm::vec4 Color = glm::vec4(1.0f);
 		glm::vec2 Tiling = glm::vec2(1.0f);
 		int Layer;
+		//Static sprites are baked into retained chunks and only rebuilt when they change
+		bool Static = false;
 		glm::vec2 SpriteCoords;
 		glm::vec2 SpriteSize;
+		//Written by the animation system, replaces the sheet cell while Animated is set
+		glm::vec4 FrameRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		bool Animated = false;
 
 		void SetTexture(Shared<Texture> texture) 
 		{ 
@@ -69,7 +76,7 @@ namespace MoonEngine
 
 		REFLECT
 		(
-			("Color", Color)("Tiling", Tiling)("Texture", m_Texture)("Layer", Layer)
+			("Color", Color)("Tiling", Tiling)("Texture", m_Texture)("Layer", Layer)("Static", Static)
 			("SpriteCoords", SpriteCoords)("SpriteSize", SpriteSize)("HasSpriteSheet", m_HasSpriteSheet)
 		)
 
@@ -79,6 +86,44 @@ namespace MoonEngine
 		bool m_HasSpriteSheet = false;
 	};
 
+	//Plays cells of the sprite texture in order, static sprites keep their sheet cell
+	struct SpriteAnimationComponent
+	{
+		glm::vec2 CellSize = glm::vec2(32.0f);
+		glm::vec2 FirstCell = glm::vec2(0.0f);
+		int FrameCount = 1;
+		float FramesPerSecond = 12.0f;
+		AnimationLoopMode LoopMode = AnimationLoopMode::Loop;
+		float Speed = 1.0f;
+		bool Playing = true;
+
+		const Shared<SpriteAnimation>& GetAnimation() const { return m_Animation; }
+
+		REFLECT
+		(
+			("CellSize", CellSize)("FirstCell", FirstCell)("FrameCount", FrameCount)("FramesPerSecond", FramesPerSecond)
+			("LoopMode", LoopMode)("Speed", Speed)("Playing", Playing)
+		)
+
+	private:
+		Shared<SpriteAnimation> m_Animation;
+
+		friend class Scene;
+	};
+
+	//Grid of tiles cut from one tileset texture, every tile covers one unit before the transform is applied
+	struct TilemapComponent
+	{
+		Shared<Texture> Tileset = nullptr;
+		//Size of a tileset cell in pixels
+		glm::vec2 TileSize = glm::vec2(16.0f);
+		glm::vec4 Color = glm::vec4(1.0f);
+		int Layer = 0;
+		Tilemap Tiles;
+
+		REFLECT(("Tileset", Tileset)("TileSize", TileSize)("Color", Color)("Layer", Layer))
+	};
+
 	struct CameraComponent
 	{
 	private:
@@ -144,5 +189,5 @@ namespace MoonEngine
 	};
 
 	using AllComponents = ComponentGroup
-		<UUIDComponent, IdentityComponent, TransformComponent, SpriteComponent, CameraComponent, ScriptComponent, PhysicsBodyComponent, ParticleComponent>;
+		<UUIDComponent, IdentityComponent, TransformComponent, SpriteComponent, SpriteAnimationComponent, TilemapComponent, CameraComponent, ScriptComponent, PhysicsBodyComponent, ParticleComponent>;
 }
\ No newline at end of file
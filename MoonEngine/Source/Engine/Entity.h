@@ -41,6 +41,13 @@ namespace MoonEngine
 			return component;
 		}
 
+		//Components are edited in place, this lets the scene know one of them changed
+		template<typename T>
+		void PatchComponent()
+		{
+			m_Scene->m_Registry.patch<T>(m_ID);
+		}
+
 		template<typename T>
 		T& GetComponent()
 		{
@@ -20,6 +20,22 @@ namespace MoonEngine
 
 	static Scene* s_ActiveScene = nullptr;
 
+	Scene::Scene()
+	{
+		m_Registry.on_construct<SpriteComponent>().connect<&Scene::OnSpriteChanged>(this);
+		m_Registry.on_update<SpriteComponent>().connect<&Scene::OnSpriteChanged>(this);
+		m_Registry.on_update<TransformComponent>().connect<&Scene::OnSpriteChanged>(this);
+		m_Registry.on_destroy<SpriteComponent>().connect<&Scene::OnSpriteDestroyed>(this);
+		m_Registry.on_destroy<TransformComponent>().connect<&Scene::OnSpriteDestroyed>(this);
+
+		m_Registry.on_construct<SpriteAnimationComponent>().connect<&Scene::OnAnimationChanged>(this);
+		m_Registry.on_update<SpriteAnimationComponent>().connect<&Scene::OnAnimationChanged>(this);
+		m_Registry.on_construct<SpriteComponent>().connect<&Scene::OnAnimationChanged>(this);
+		m_Registry.on_update<SpriteComponent>().connect<&Scene::OnAnimationChanged>(this);
+		m_Registry.on_destroy<SpriteAnimationComponent>().connect<&Scene::OnAnimationDestroyed>(this);
+		m_Registry.on_destroy<SpriteComponent>().connect<&Scene::OnAnimationDestroyed>(this);
+	}
+
 	void Scene::SetActiveScene(Scene* scene)
 	{
 		s_ActiveScene = scene;
@@ -140,7 +156,13 @@ namespace MoonEngine
 				});
 
 				for (auto [e, transform, physicsBody] : view.each())
+				{
 					m_PhysicsWorld.UpdatePhysicsBodies(Entity{ e, this }, transform, physicsBody);
+
+					//Moved bodies are patched so the grid and static chunks follow them
+					if (physicsBody.Type != PhysicsBodyComponent::BodyType::Static)
+						m_Registry.patch<TransformComponent>(e);
+				}
 			}
 
 			//Particle System
@@ -153,6 +175,318 @@ namespace MoonEngine
 				}
 			}
 		}
+
+		//Sprite Animations, still written while paused so edits show up in the editor
+		m_SpriteAnimations.Update(update ? dt : 0.0f, m_Registry);
+	}
+
+	void Scene::GetViewBounds(const glm::mat4& viewProjection, glm::vec2& min, glm::vec2& max)
+	{
+		const glm::mat4& inverse = glm::inverse(viewProjection);
+		min = glm::vec2(std::numeric_limits<float>::max());
+		max = glm::vec2(std::numeric_limits<float>::lowest());
+
+		for (float x : { -1.0f, 1.0f })
+		{
+			for (float y : { -1.0f, 1.0f })
+			{
+				glm::vec4 corner = inverse * glm::vec4(x, y, 0.0f, 1.0f);
+				corner /= corner.w;
+				min = glm::min(min, glm::vec2(corner));
+				max = glm::max(max, glm::vec2(corner));
+			}
+		}
+	}
+
+	void Scene::MarkGridDirty(entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_GridQueued.size())
+			m_GridQueued.resize(index + 1, entt::null);
+
+		if (m_GridQueued[index] == entity)
+			return;
+
+		m_GridQueued[index] = entity;
+		m_GridDirty.push_back(entity);
+	}
+
+	void Scene::UpdateSpatialGrid()
+	{
+		//Only sprites patched since the last update are placed again, the cost follows what moved instead of the world size
+		for (entt::entity e : m_GridDirty)
+		{
+			uint32_t index = (uint32_t)entt::to_entity(e);
+			if (m_GridQueued[index] != e)
+				continue;
+			m_GridQueued[index] = entt::null;
+
+			//Destroyed sprites already left the grid, a recycled index is queued under its new entity
+			if (!m_Registry.valid(e))
+				continue;
+
+			const TransformComponent* transform = m_Registry.try_get<TransformComponent>(e);
+			if (!transform || !m_Registry.all_of<SpriteComponent>(e))
+			{
+				m_SpatialGrid.Remove(e);
+				continue;
+			}
+
+			glm::vec2 extents;
+			if (transform->Rotation.x == 0.0f && transform->Rotation.y == 0.0f)
+			{
+				float sine = std::abs(std::sin(transform->Rotation.z));
+				float cosine = std::abs(std::cos(transform->Rotation.z));
+				float halfX = std::abs(transform->Scale.x) * 0.5f;
+				float halfY = std::abs(transform->Scale.y) * 0.5f;
+				extents = { cosine * halfX + sine * halfY, sine * halfX + cosine * halfY };
+			}
+			else
+				extents = glm::vec2(glm::length(glm::vec2(transform->Scale)) * 0.5f);
+
+			m_SpatialGrid.Update(e, glm::vec2(transform->Position) - extents, glm::vec2(transform->Position) + extents);
+		}
+
+		m_GridDirty.clear();
+	}
+
+	SpriteQuery Scene::QueryVisibleSprites(const glm::mat4& viewProjection)
+	{
+		//Every view of a frame shares the grid update and the items it builds
+		uint64_t frame = Renderer::GetStats().Frame + 1;
+		if (m_GridFrame != frame)
+		{
+			UpdateSpatialGrid();
+			m_GridFrame = frame;
+		}
+
+		glm::vec2 min, max;
+		GetViewBounds(viewProjection, min, max);
+
+		m_GridResult.clear();
+		m_SpatialGrid.Query(min, max, m_GridResult);
+
+		//Grid order changes as sprites move, sorting keeps equal layers drawing in a stable order
+		std::sort(m_GridResult.begin(), m_GridResult.end());
+
+		const TransformComponent* transforms[Renderer::SpriteBlockSize];
+		const SpriteComponent* sprites[Renderer::SpriteBlockSize];
+		uint32_t staleIndices[Renderer::SpriteBlockSize];
+		uint32_t staleCount = 0;
+
+		auto buildStale = [&]
+		{
+			SpriteRenderItem* items[Renderer::SpriteBlockSize];
+			for (uint32_t i = 0; i < staleCount; i++)
+				items[i] = &m_RenderItems[staleIndices[i]];
+
+			Renderer::BuildSpriteItems(transforms, sprites, items, staleCount);
+			staleCount = 0;
+		};
+
+		m_VisibleIndices.clear();
+		for (entt::entity e : m_GridResult)
+		{
+			//Static sprites stay in the grid for picking but are drawn from their retained chunks
+			const SpriteComponent& sprite = m_Registry.get<SpriteComponent>(e);
+			if (sprite.Static)
+				continue;
+
+			uint32_t index = (uint32_t)entt::to_entity(e);
+			if (index >= m_RenderItems.size())
+			{
+				m_RenderItems.resize(index + 1);
+				m_RenderItemFrames.resize(index + 1, 0);
+			}
+
+			m_VisibleIndices.push_back(index);
+			if (m_RenderItemFrames[index] == frame)
+				continue;
+
+			m_RenderItemFrames[index] = frame;
+			transforms[staleCount] = &m_Registry.get<TransformComponent>(e);
+			sprites[staleCount] = &sprite;
+			staleIndices[staleCount] = index;
+
+			if (++staleCount == Renderer::SpriteBlockSize)
+				buildStale();
+		}
+
+		if (staleCount > 0)
+			buildStale();
+
+		//Items only move while resizing, so pointers are taken once the list is complete
+		m_VisibleSprites.clear();
+		for (uint32_t index : m_VisibleIndices)
+			m_VisibleSprites.push_back(&m_RenderItems[index]);
+
+		return { &m_VisibleSprites };
+	}
+
+	//Where the ray crosses the plane of the sprite, in the uv space of its quad
+	static bool HitSprite(const TransformComponent& transform, const glm::vec3& origin, const glm::vec3& direction, glm::vec2& uv)
+	{
+		const glm::mat4& model = glm::translate(glm::mat4(1.0f), transform.Position) * glm::toMat4(glm::quat(transform.Rotation)) * glm::scale(glm::mat4(1.0f), transform.Scale);
+		glm::vec3 axisX = model[0];
+		glm::vec3 axisY = model[1];
+		glm::vec3 position = model[3];
+
+		glm::vec3 normal = glm::cross(axisX, axisY);
+		float facing = glm::dot(normal, direction);
+		if (std::abs(facing) < 1e-8f)
+			return false;
+
+		glm::vec3 offset = origin + direction * (glm::dot(normal, position - origin) / facing) - position;
+
+		//Axes of a skewed or scaled quad are not orthonormal, so the offset is solved against both at once
+		float xx = glm::dot(axisX, axisX);
+		float xy = glm::dot(axisX, axisY);
+		float yy = glm::dot(axisY, axisY);
+		float ox = glm::dot(offset, axisX);
+		float oy = glm::dot(offset, axisY);
+		float determinant = xx * yy - xy * xy;
+
+		float u = (ox * yy - oy * xy) / determinant;
+		float v = (oy * xx - ox * xy) / determinant;
+		if (std::abs(u) > 0.5f || std::abs(v) > 0.5f)
+			return false;
+
+		uv = { u + 0.5f, v + 0.5f };
+		return true;
+	}
+
+	//Same lookup the sprite shaders do, a texel they would discard is not hit
+	static bool IsOpaque(const SpriteComponent& sprite, const glm::vec2& uv)
+	{
+		const TextureSheet* sheet = sprite.Animated ? nullptr : sprite.GetTextureSheet().get();
+		const Shared<Texture>& texture = sheet ? sheet->GetTexture() : sprite.GetTexture();
+
+		float alpha = sprite.Color.a;
+		if (texture)
+		{
+			glm::vec2 texCoord = uv;
+			if (sprite.Animated)
+				texCoord = glm::mix(glm::vec2(sprite.FrameRect), glm::vec2(sprite.FrameRect.z, sprite.FrameRect.w), uv);
+			else if (sheet)
+				texCoord = glm::mix(sheet->GetTexCoord(0), sheet->GetTexCoord(2), uv);
+			alpha *= texture->SampleAlpha(texCoord * sprite.Tiling);
+		}
+
+		return alpha > 0.0f;
+	}
+
+	Entity Scene::PickSprite(const glm::mat4& viewProjection, const glm::vec2& point, bool alphaMask)
+	{
+		UpdateSpatialGrid();
+
+		//Ray through the point from the near to the far plane
+		const glm::mat4& inverse = glm::inverse(viewProjection);
+		glm::vec4 nearPoint = inverse * glm::vec4(point, -1.0f, 1.0f);
+		glm::vec4 farPoint = inverse * glm::vec4(point, 1.0f, 1.0f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		glm::vec3 direction = glm::vec3(farPoint) / farPoint.w - origin;
+
+		//Grid bounds are flat, they are searched where the ray crosses z = 0
+		glm::vec2 center = direction.z != 0.0f ? glm::vec2(origin - direction * (origin.z / direction.z)) : glm::vec2(origin);
+		m_GridResult.clear();
+		m_SpatialGrid.Query(center, center, m_GridResult);
+
+		entt::entity picked = entt::null;
+		int pickedLayer = std::numeric_limits<int>::min();
+		bool pickedDynamic = false;
+		for (entt::entity e : m_GridResult)
+		{
+			const TransformComponent* transform = m_Registry.try_get<TransformComponent>(e);
+			const SpriteComponent* sprite = m_Registry.try_get<SpriteComponent>(e);
+			if (!transform || !sprite)
+				continue;
+
+			//Higher layers draw on top and static chunks draw beneath the streamed quads of their layer.
+			//Past that the renderer groups a layer by texture in the order textures are first used in the frame,
+			//which picking cannot see, so the later entity wins and overlapping sprites with different textures may pick the one beneath
+			bool dynamic = !sprite->Static;
+			if (sprite->Layer != pickedLayer)
+			{
+				if (sprite->Layer < pickedLayer)
+					continue;
+			}
+			else if (dynamic != pickedDynamic)
+			{
+				if (!dynamic)
+					continue;
+			}
+			else if (e < picked)
+				continue;
+
+			glm::vec2 uv;
+			if (!HitSprite(*transform, origin, direction, uv) || (alphaMask && !IsOpaque(*sprite, uv)))
+				continue;
+
+			picked = e;
+			pickedLayer = sprite->Layer;
+			pickedDynamic = dynamic;
+		}
+
+		return picked == entt::null ? Entity{} : Entity{ picked, this };
+	}
+
+	void Scene::OnSpriteChanged(entt::registry& registry, entt::entity entity)
+	{
+		const TransformComponent* transform = registry.try_get<TransformComponent>(entity);
+		const SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity);
+
+		if (transform && sprite && sprite->Static)
+			m_StaticSprites.Insert((uint32_t)entity, *transform, *sprite);
+		else
+			m_StaticSprites.Remove((uint32_t)entity);
+
+		InvalidateRenderItem(entity);
+		MarkGridDirty(entity);
+	}
+
+	void Scene::OnSpriteDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		m_StaticSprites.Remove((uint32_t)entity);
+		m_SpatialGrid.Remove(entity);
+		InvalidateRenderItem(entity);
+	}
+
+	void Scene::InvalidateRenderItem(entt::entity entity)
+	{
+		//Views later in the frame rebuild the item instead of replaying one made before the change
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index < m_RenderItemFrames.size())
+		{
+			m_RenderItemFrames[index] = 0;
+			m_RenderItems[index].Texture = nullptr;
+		}
+	}
+
+	void Scene::OnAnimationChanged(entt::registry& registry, entt::entity entity)
+	{
+		SpriteAnimationComponent* animation = registry.try_get<SpriteAnimationComponent>(entity);
+		if (!animation)
+			return;
+
+		SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity);
+		if (!sprite || sprite->Static || !sprite->GetTexture())
+		{
+			animation->m_Animation = nullptr;
+			OnAnimationDestroyed(registry, entity);
+			return;
+		}
+
+		animation->m_Animation = SpriteAnimation::Get(sprite->GetTexture(), glm::max(animation->CellSize, glm::vec2(1.0f)), animation->FirstCell,
+			(uint32_t)std::max(animation->FrameCount, 1), animation->FramesPerSecond, animation->LoopMode);
+		m_SpriteAnimations.Set(entity, animation->m_Animation, animation->Playing ? animation->Speed : 0.0f);
+	}
+
+	void Scene::OnAnimationDestroyed(entt::registry& registry, entt::entity entity)
+	{
+		m_SpriteAnimations.Remove(entity);
+
+		if (SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity))
+			sprite->Animated = false;
 	}
 
 	template<typename T>
@@ -206,6 +540,8 @@ namespace MoonEngine
 		CopyIfExists<IdentityComponent>(to, from);
 		CopyIfExists<TransformComponent>(to, from);
 		CopyIfExists<SpriteComponent>(to, from);
+		CopyIfExists<SpriteAnimationComponent>(to, from);
+		CopyIfExists<TilemapComponent>(to, from);
 		CopyIfExists<CameraComponent>(to, from);
 		CopyIfExists<ParticleComponent>(to, from);
 		CopyIfExists<PhysicsBodyComponent>(to, from);
@@ -235,6 +571,8 @@ namespace MoonEngine
 		RemoveIfExists<PhysicsBodyComponent>(e);
 		RemoveIfExists<ParticleComponent>(e);
 		RemoveIfExists<CameraComponent>(e);
+		RemoveIfExists<TilemapComponent>(e);
+		RemoveIfExists<SpriteAnimationComponent>(e);
 		RemoveIfExists<SpriteComponent>(e);
 		RemoveIfExists<IdentityComponent>(e);
 		RemoveIfExists<TransformComponent>(e);
@@ -257,6 +595,8 @@ namespace MoonEngine
 			CopyIfExists<IdentityComponent>(copyTo, copyFrom);
 			CopyIfExists<TransformComponent>(copyTo, copyFrom);
 			CopyIfExists<SpriteComponent>(copyTo, copyFrom);
+			CopyIfExists<SpriteAnimationComponent>(copyTo, copyFrom);
+			CopyIfExists<TilemapComponent>(copyTo, copyFrom);
 			CopyIfExists<CameraComponent>(copyTo, copyFrom);
 			CopyIfExists<ParticleComponent>(copyTo, copyFrom);
 			CopyIfExists<PhysicsBodyComponent>(copyTo, copyFrom);
@@ -329,7 +669,22 @@ namespace MoonEngine
 	void Scene::OnAddComponent(Entity entity, SpriteComponent& component) {}
 
 	template<>
-	void Scene::OnRemoveComponent(Entity entity, SpriteComponent& component) {}
+	void Scene::OnRemoveComponent(Entity entity, SpriteComponent& component)
+	{
+		m_SpatialGrid.Remove(entity.m_ID);
+	}
+
+	template<>
+	void Scene::OnAddComponent(Entity entity, SpriteAnimationComponent& component) {}
+
+	template<>
+	void Scene::OnRemoveComponent(Entity entity, SpriteAnimationComponent& component) {}
+
+	template<>
+	void Scene::OnAddComponent(Entity entity, TilemapComponent& component) {}
+
+	template<>
+	void Scene::OnRemoveComponent(Entity entity, TilemapComponent& component) {}
 
 	template<>
 	void Scene::OnAddComponent(Entity entity, CameraComponent& component) {}
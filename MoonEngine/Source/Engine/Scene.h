@@ -1,4 +1,6 @@
 #pragma once
+#include "Engine/SpatialGrid.h"
+#include "Engine/Systems/SpriteAnimationSystem.h"
 #include "Physics/PhysicsWorld.h"
 
 #include "Renderer/Renderer.h"
@@ -10,10 +12,13 @@ namespace MoonEngine
 	class Entity;
 	class Camera;
 
+	struct TransformComponent;
+	struct SpriteComponent;
+
 	class Scene
 	{
 	public:
-		Scene() = default;
+		Scene();
 		~Scene() = default;
 
 		std::string SceneName = "New Scene";
@@ -34,6 +39,17 @@ namespace MoonEngine
 
 		void CreateSciptInstances();
 
+		//Dynamic sprites overlapping the area a camera sees, ready for Renderer::DrawSprites. The result stays valid until the next query
+		//Sprites are resolved to world space quads the first time a view sees them in a frame, later views replay them
+		SpriteQuery QueryVisibleSprites(const glm::mat4& viewProjection);
+		//Sprites flagged static, kept up to date through the registry signals
+		StaticBatch& GetStaticSprites() { return m_StaticSprites; }
+		static void GetViewBounds(const glm::mat4& viewProjection, glm::vec2& min, glm::vec2& max);
+		//Topmost sprite under a point in normalized device coordinates, found on the cpu so it needs no gpu readback
+		//alphaMask ignores the parts of a sprite its texture leaves transparent. Ties inside a layer follow the draw only as far as
+		//static before dynamic, overlapping sprites of one layer with different textures can pick the one drawn beneath
+		Entity PickSprite(const glm::mat4& viewProjection, const glm::vec2& point, bool alphaMask = true);
+
 		Entity FindEntityWithUUID(UUID uuid);
 		Entity FindEntityWithName(std::string_view name);
 
@@ -44,6 +60,32 @@ namespace MoonEngine
 		std::unordered_map<UUID, entt::entity> m_UUIDRegistry;
 
 		PhysicsWorld m_PhysicsWorld;
+
+		//Sprites placed or patched since the last grid update, transform writers have to patch for a sprite to move in the grid
+		SpatialGrid m_SpatialGrid;
+		std::vector<entt::entity> m_GridDirty;
+		//Entity each index is queued as, so a sprite is queued once however often it is patched
+		std::vector<entt::entity> m_GridQueued;
+		std::vector<entt::entity> m_GridResult;
+		void UpdateSpatialGrid();
+		void MarkGridDirty(entt::entity entity);
+
+		//Render items indexed like the grid records, stamped with the frame they were built in plus one
+		std::vector<SpriteRenderItem> m_RenderItems;
+		std::vector<uint64_t> m_RenderItemFrames;
+		uint64_t m_GridFrame = 0;
+		std::vector<uint32_t> m_VisibleIndices;
+		std::vector<const SpriteRenderItem*> m_VisibleSprites;
+
+		StaticBatch m_StaticSprites;
+		void OnSpriteChanged(entt::registry& registry, entt::entity entity);
+		void OnSpriteDestroyed(entt::registry& registry, entt::entity entity);
+		void InvalidateRenderItem(entt::entity entity);
+
+		SpriteAnimationSystem m_SpriteAnimations;
+		void OnAnimationChanged(entt::registry& registry, entt::entity entity);
+		void OnAnimationDestroyed(entt::registry& registry, entt::entity entity);
+
 		void OnCollisionBegin(void*, void*);
 		void OnCollisionEnd(void*, void*);
 
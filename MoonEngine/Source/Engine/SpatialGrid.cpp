@@ -0,0 +1,175 @@
+#include "mpch.h"
+#include "Engine/SpatialGrid.h"
+
+namespace MoonEngine
+{
+	//Bounds covering more cells than this are cheaper to test on every query than to spread over the grid
+	static constexpr int32_t MaxCellsPerEntity = 64;
+
+	SpatialGrid::SpatialGrid(float cellSize)
+		:m_CellSize(cellSize), m_InverseCellSize(1.0f / cellSize)
+	{
+	}
+
+	void SpatialGrid::Update(entt::entity entity, const glm::vec2& min, const glm::vec2& max)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Records.size())
+			m_Records.resize(index + 1);
+
+		GridRecord& record = m_Records[index];
+		if (record.Entity != entity)
+		{
+			if (record.Entity != entt::null)
+				Remove(record.Entity);
+
+			record.Entity = entity;
+			m_EntityCount++;
+		}
+		else
+		{
+			if (GetCellRange(min, max) == record.Cells)
+			{
+				record.Min = min;
+				record.Max = max;
+				return;
+			}
+
+			Unlink(record);
+		}
+
+		record.Min = min;
+		record.Max = max;
+		record.Cells = GetCellRange(min, max);
+		Link(record);
+	}
+
+	void SpatialGrid::Remove(entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Records.size() || m_Records[index].Entity != entity)
+			return;
+
+		GridRecord& record = m_Records[index];
+		Unlink(record);
+		record = GridRecord();
+		m_EntityCount--;
+	}
+
+	void SpatialGrid::Clear()
+	{
+		m_Records.clear();
+		m_Cells.clear();
+		m_Oversized.clear();
+		m_EntityCount = 0;
+	}
+
+	void SpatialGrid::Query(const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& result)
+	{
+		m_QueryStamp++;
+		const CellRange& range = GetCellRange(min, max);
+		uint64_t cellCount = (uint64_t)(range.MaxX - range.MinX + 1) * (uint64_t)(range.MaxY - range.MinY + 1);
+
+		//Zoomed far out the area covers more cells than exist, walking the occupied ones is cheaper
+		if (cellCount > m_Cells.size())
+		{
+			for (auto& [key, entities] : m_Cells)
+				for (entt::entity entity : entities)
+					Collect(m_Records[(uint32_t)entt::to_entity(entity)], min, max, result);
+		}
+		else
+		{
+			for (int32_t y = range.MinY; y <= range.MaxY; y++)
+			{
+				for (int32_t x = range.MinX; x <= range.MaxX; x++)
+				{
+					auto it = m_Cells.find(GetCellKey(x, y));
+					if (it == m_Cells.end())
+						continue;
+
+					for (entt::entity entity : it->second)
+						Collect(m_Records[(uint32_t)entt::to_entity(entity)], min, max, result);
+				}
+			}
+		}
+
+		for (entt::entity entity : m_Oversized)
+			Collect(m_Records[(uint32_t)entt::to_entity(entity)], min, max, result);
+	}
+
+	SpatialGrid::CellRange SpatialGrid::GetCellRange(const glm::vec2& min, const glm::vec2& max) const
+	{
+		//Clamped so far away or broken bounds can not overflow the cell coordinates
+		const float limit = (float)(1 << 30);
+
+		CellRange range;
+		range.MinX = (int32_t)std::floor(std::clamp(min.x * m_InverseCellSize, -limit, limit));
+		range.MinY = (int32_t)std::floor(std::clamp(min.y * m_InverseCellSize, -limit, limit));
+		range.MaxX = (int32_t)std::floor(std::clamp(max.x * m_InverseCellSize, -limit, limit));
+		range.MaxY = (int32_t)std::floor(std::clamp(max.y * m_InverseCellSize, -limit, limit));
+		return range;
+	}
+
+	void SpatialGrid::Link(GridRecord& record)
+	{
+		const CellRange& range = record.Cells;
+		int64_t cellCount = (int64_t)(range.MaxX - range.MinX + 1) * (int64_t)(range.MaxY - range.MinY + 1);
+
+		record.Oversized = cellCount > MaxCellsPerEntity;
+		if (record.Oversized)
+		{
+			m_Oversized.push_back(record.Entity);
+			return;
+		}
+
+		for (int32_t y = range.MinY; y <= range.MaxY; y++)
+			for (int32_t x = range.MinX; x <= range.MaxX; x++)
+				m_Cells[GetCellKey(x, y)].push_back(record.Entity);
+	}
+
+	void SpatialGrid::Unlink(GridRecord& record)
+	{
+		auto eraseFrom = [&](std::vector<entt::entity>& entities)
+		{
+			auto it = std::find(entities.begin(), entities.end(), record.Entity);
+			if (it == entities.end())
+				return;
+
+			*it = entities.back();
+			entities.pop_back();
+		};
+
+		if (record.Oversized)
+		{
+			eraseFrom(m_Oversized);
+			return;
+		}
+
+		const CellRange& range = record.Cells;
+		for (int32_t y = range.MinY; y <= range.MaxY; y++)
+		{
+			for (int32_t x = range.MinX; x <= range.MaxX; x++)
+			{
+				auto it = m_Cells.find(GetCellKey(x, y));
+				if (it == m_Cells.end())
+					continue;
+
+				eraseFrom(it->second);
+				if (it->second.empty())
+					m_Cells.erase(it);
+			}
+		}
+	}
+
+	void SpatialGrid::Collect(GridRecord& record, const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& result)
+	{
+		if (record.QueryStamp == m_QueryStamp)
+			return;
+
+		record.QueryStamp = m_QueryStamp;
+		if (record.Max.x < min.x || record.Min.x > max.x || record.Max.y < min.y || record.Min.y > max.y)
+			return;
+
+		result.push_back(record.Entity);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <entt.hpp>
+
+namespace MoonEngine
+{
+	//Uniform grid of entity bounds on the xy plane. Entities are stored in every cell their bounds touch,
+	//bounds that would span too many cells are kept in a separate list that every query tests
+	class SpatialGrid
+	{
+	public:
+		SpatialGrid(float cellSize = 8.0f);
+
+		//Inserts the entity or moves it, cells are only touched when its bounds cross a cell border
+		void Update(entt::entity entity, const glm::vec2& min, const glm::vec2& max);
+		void Remove(entt::entity entity);
+		void Clear();
+		bool Contains(entt::entity entity) const
+		{
+			uint32_t index = (uint32_t)entt::to_entity(entity);
+			return index < m_Records.size() && m_Records[index].Entity == entity;
+		}
+
+		//Appends every entity whose bounds overlap the area, each entity is reported once
+		void Query(const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& result);
+
+		uint32_t GetEntityCount() const { return m_EntityCount; }
+	private:
+		struct CellRange
+		{
+			int32_t MinX = 0;
+			int32_t MinY = 0;
+			int32_t MaxX = -1;
+			int32_t MaxY = -1;
+
+			bool operator==(const CellRange& other) const { return MinX == other.MinX && MinY == other.MinY && MaxX == other.MaxX && MaxY == other.MaxY; }
+		};
+
+		struct GridRecord
+		{
+			entt::entity Entity = entt::null;
+			glm::vec2 Min = glm::vec2(0.0f);
+			glm::vec2 Max = glm::vec2(0.0f);
+			CellRange Cells;
+			bool Oversized = false;
+			uint32_t QueryStamp = 0;
+		};
+
+		float m_CellSize;
+		float m_InverseCellSize;
+		uint32_t m_EntityCount = 0;
+		uint32_t m_QueryStamp = 0;
+
+		//Indexed by the entity part of the identifier
+		std::vector<GridRecord> m_Records;
+		std::unordered_map<uint64_t, std::vector<entt::entity>> m_Cells;
+		std::vector<entt::entity> m_Oversized;
+
+		CellRange GetCellRange(const glm::vec2& min, const glm::vec2& max) const;
+		static uint64_t GetCellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+		void Link(GridRecord& record);
+		void Unlink(GridRecord& record);
+		void Collect(GridRecord& record, const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& result);
+	};
+}
\ No newline at end of file
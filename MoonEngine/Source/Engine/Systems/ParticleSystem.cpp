@@ -95,7 +95,15 @@ namespace MoonEngine
 		}
 	}
 
-	void ParticleSystem::DrawParticles(int entityId)
+	static bool IsParticleVisible(const Particle& particle, const glm::vec2& viewMin, const glm::vec2& viewMax)
+	{
+		//Half diagonal of the quad covers every rotation
+		float radius = glm::length(glm::vec2(particle.Scale)) * 0.5f;
+		return particle.Position.x + radius >= viewMin.x && particle.Position.x - radius <= viewMax.x &&
+			   particle.Position.y + radius >= viewMin.y && particle.Position.y - radius <= viewMax.y;
+	}
+
+	void ParticleSystem::DrawParticles(const glm::vec2& viewMin, const glm::vec2& viewMax)
 	{
 		if (!m_IsPlaying && !m_IsPaused)
 			return;
@@ -105,9 +113,9 @@ namespace MoonEngine
 			for (uint32_t i = 0; i < m_PoolSize; i++)
 			{
 				Particle& particle = m_Particles[i];
-				if (!particle.IsActive)
+				if (!particle.IsActive || !IsParticleVisible(particle, viewMin, viewMax))
 					continue;
-				Renderer::DrawEntity(particle.Position, particle.Scale, particle.Rotation, particle.Color, particle.Texture, Layer, { 1.0f, 1.0f }, entityId);
+				Renderer::DrawEntity(particle.Position, particle.Scale, particle.Rotation, particle.Color, particle.Texture, Layer);
 			}
 		}
 		else if (SortMode == SortMode::OldestInFront)
@@ -115,9 +123,9 @@ namespace MoonEngine
 			for (uint32_t i = m_PoolSize - 1; i > 0; i--)
 			{
 				Particle& particle = m_Particles[i];
-				if (!particle.IsActive)
+				if (!particle.IsActive || !IsParticleVisible(particle, viewMin, viewMax))
 					continue;
-				Renderer::DrawEntity(particle.Position, particle.Scale, particle.Rotation, particle.Color, particle.Texture, Layer, { 1.0f, 1.0f }, entityId);
+				Renderer::DrawEntity(particle.Position, particle.Scale, particle.Rotation, particle.Color, particle.Texture, Layer);
 			}
 		}
 	}
@@ -118,7 +118,8 @@ namespace MoonEngine
 
 		void UpdateEmitter(float dt, const ParticleBody& particle, const glm::vec3& position);
 		void UpdateParticles(float dt);
-		void DrawParticles(int entityId);
+		//Particles outside the view bounds are skipped
+		void DrawParticles(const glm::vec2& viewMin, const glm::vec2& viewMax);
 
 		SortMode SortMode = SortMode::YoungestInFront;
 		EmitterType EmitterType = EmitterType::Cone;
@@ -0,0 +1,89 @@
+#include "mpch.h"
+#include "Engine/Systems/SpriteAnimationSystem.h"
+
+#include "Engine/Components.h"
+#include "Renderer/SpriteAnimation.h"
+
+namespace MoonEngine
+{
+	uint32_t& SpriteAnimationSystem::GetSlot(entt::entity entity)
+	{
+		uint32_t index = (uint32_t)entt::to_entity(entity);
+		if (index >= m_Slots.size())
+			m_Slots.resize(index + 1, InvalidSlot);
+
+		return m_Slots[index];
+	}
+
+	void SpriteAnimationSystem::Set(entt::entity entity, const Shared<SpriteAnimation>& animation, float speed)
+	{
+		uint32_t& slot = GetSlot(entity);
+		if (slot == InvalidSlot)
+		{
+			slot = (uint32_t)m_Entities.size();
+			m_Entities.push_back(entity);
+			m_Animations.push_back(animation);
+			m_Times.push_back(0.0f);
+			m_Speeds.push_back(speed);
+			return;
+		}
+
+		m_Animations[slot] = animation;
+		m_Times[slot] = animation->WrapTime(m_Times[slot]);
+		m_Speeds[slot] = speed;
+	}
+
+	void SpriteAnimationSystem::Remove(entt::entity entity)
+	{
+		uint32_t& slot = GetSlot(entity);
+		if (slot == InvalidSlot)
+			return;
+
+		//Swap the last animator into the hole so the arrays stay packed
+		uint32_t index = slot;
+		uint32_t last = (uint32_t)m_Entities.size() - 1;
+		if (index != last)
+		{
+			m_Entities[index] = m_Entities[last];
+			m_Animations[index] = std::move(m_Animations[last]);
+			m_Times[index] = m_Times[last];
+			m_Speeds[index] = m_Speeds[last];
+			GetSlot(m_Entities[index]) = index;
+		}
+
+		m_Entities.pop_back();
+		m_Animations.pop_back();
+		m_Times.pop_back();
+		m_Speeds.pop_back();
+		slot = InvalidSlot;
+	}
+
+	void SpriteAnimationSystem::Clear()
+	{
+		m_Entities.clear();
+		m_Animations.clear();
+		m_Times.clear();
+		m_Speeds.clear();
+		m_Slots.clear();
+	}
+
+	void SpriteAnimationSystem::Update(float dt, entt::registry& registry)
+	{
+		uint32_t count = (uint32_t)m_Entities.size();
+
+		for (uint32_t i = 0; i < count; i++)
+			m_Times[i] = m_Animations[i]->WrapTime(m_Times[i] + dt * m_Speeds[i]);
+
+		//Written every frame so clips whose texture finished loading pick up the new rects
+		for (uint32_t i = 0; i < count; i++)
+		{
+			SpriteComponent* sprite = registry.try_get<SpriteComponent>(m_Entities[i]);
+			if (!sprite || sprite->Static)
+				continue;
+
+			const SpriteAnimation& animation = *m_Animations[i];
+			sprite->FrameRect = animation.GetFrame(animation.GetFrameAt(m_Times[i]));
+			sprite->Animated = true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <entt.hpp>
+
+namespace MoonEngine
+{
+	class SpriteAnimation;
+
+	//Playback state of every animated sprite kept in parallel arrays so advancing them is one tight loop
+	class SpriteAnimationSystem
+	{
+	public:
+		//Keeps the playback time when the entity is already animated
+		void Set(entt::entity entity, const Shared<SpriteAnimation>& animation, float speed);
+		void Remove(entt::entity entity);
+		void Clear();
+
+		//Advances every clip and writes the current frame rect into the sprites
+		void Update(float dt, entt::registry& registry);
+
+		uint32_t GetCount() const { return (uint32_t)m_Entities.size(); }
+	private:
+		std::vector<entt::entity> m_Entities;
+		std::vector<Shared<SpriteAnimation>> m_Animations;
+		std::vector<float> m_Times;
+		std::vector<float> m_Speeds;
+
+		//Dense index of each entity, indexed by the entity slot
+		std::vector<uint32_t> m_Slots;
+		static constexpr uint32_t InvalidSlot = 0xffffffff;
+
+		uint32_t& GetSlot(entt::entity entity);
+	};
+}
\ No newline at end of file
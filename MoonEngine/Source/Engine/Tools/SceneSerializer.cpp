@@ -6,6 +6,8 @@
 #include "Engine/UUID.h"
 #include "Engine/Scene.h"
 
+#include "Renderer/TextureLoader.h"
+
 #include "Scripting/ScriptEngine.h"
 
 #include <yaml-cpp/yaml.h>
@@ -180,6 +182,12 @@ namespace MoonEngine
 		return out;
 	}
 
+	YAML::Emitter& operator<<(YAML::Emitter& out, AnimationLoopMode lm)
+	{
+		out << (int)lm;
+		return out;
+	}
+
 	struct YAMLSerializer
 	{
 		YAMLSerializer(YAML::Emitter& out)
@@ -257,6 +265,16 @@ namespace MoonEngine
 			return *this;
 		}
 
+		YAMLDeserializer& operator()(const char* propertyID, AnimationLoopMode& field) {
+			auto propNode = Node[propertyID];
+			if (!propNode)
+				return *this;
+
+			auto type = propNode.as<int>();
+			field = (AnimationLoopMode)type;
+			return *this;
+		}
+
 		YAMLDeserializer& operator()(const char* propertyID, Shared<Texture>& field) {
 			auto propNode = Node[propertyID];
 			if (!propNode)
@@ -265,7 +283,7 @@ namespace MoonEngine
 			auto path = propNode.as<std::string>();
 
 			if (path != "null")
-				field = MakeShared<Texture>(path);
+				field = TextureLoader::Load(path);
 
 			return *this;
 		}
@@ -339,6 +357,70 @@ namespace MoonEngine
 		}
 	}
 
+	//Chunks are written as runs of count and stored tile pairs, a level is mostly long stretches of one tile or of nothing
+	void SerializeTiles(YAML::Emitter& out, const Tilemap& tilemap)
+	{
+		out << YAML::Key << "Chunks" << YAML::Value << YAML::BeginSeq;
+
+		std::vector<uint32_t> runs;
+		for (uint32_t chunk = 0; chunk < tilemap.GetChunkCount(); chunk++)
+		{
+			const uint16_t* tiles = tilemap.GetChunkTiles(chunk);
+
+			runs.clear();
+			for (uint32_t i = 0; i < Tilemap::ChunkTiles; i++)
+			{
+				if (!runs.empty() && runs.back() == tiles[i])
+					runs[runs.size() - 2]++;
+				else
+				{
+					runs.push_back(1);
+					runs.push_back(tiles[i]);
+				}
+			}
+
+			if (runs.size() == 2 && runs[1] == Tilemap::EmptyTile)
+				continue;
+
+			const glm::ivec2& coord = tilemap.GetChunkCoord(chunk);
+			out << YAML::BeginMap;
+			out << YAML::Key << "Coord" << YAML::Value << YAML::Flow << YAML::BeginSeq << coord.x << coord.y << YAML::EndSeq;
+			out << YAML::Key << "Runs" << YAML::Value << YAML::Flow << runs;
+			out << YAML::EndMap;
+		}
+
+		out << YAML::EndSeq;
+	}
+
+	void DeserializeTiles(const YAML::Node& node, Tilemap& tilemap)
+	{
+		tilemap.Clear();
+
+		auto chunks = node["Chunks"];
+		if (!chunks)
+			return;
+
+		std::vector<uint16_t> tiles(Tilemap::ChunkTiles);
+		for (auto chunk : chunks)
+		{
+			auto coord = chunk["Coord"].as<std::vector<int>>();
+			auto runs = chunk["Runs"].as<std::vector<uint32_t>>();
+			if (coord.size() != 2)
+				continue;
+
+			uint32_t tile = 0;
+			for (size_t run = 0; run + 1 < runs.size() && tile < Tilemap::ChunkTiles; run += 2)
+			{
+				uint32_t end = std::min(tile + runs[run], Tilemap::ChunkTiles);
+				std::fill(tiles.begin() + tile, tiles.begin() + end, (uint16_t)runs[run + 1]);
+				tile = end;
+			}
+			std::fill(tiles.begin() + tile, tiles.end(), Tilemap::EmptyTile);
+
+			tilemap.SetChunkTiles({ coord[0], coord[1] }, tiles.data());
+		}
+	}
+
 	void SerializeEntity(YAML::Emitter& out, Entity entity)
 	{
 		out << YAML::BeginMap;
@@ -349,6 +431,17 @@ namespace MoonEngine
 		SerializeIfExists<TransformComponent>(out, entity);
 		SerializeIfExists<CameraComponent>(out, entity);
 		SerializeIfExists<SpriteComponent>(out, entity);
+		SerializeIfExists<SpriteAnimationComponent>(out, entity);
+
+		if (entity.HasComponent<TilemapComponent>())
+		{
+			YAMLSerializer parser(out);
+			TilemapComponent& c = entity.GetComponent<TilemapComponent>();
+			parser.BeginParse(GetTypeName<TilemapComponent>());
+			parser.Serialize(c);
+			SerializeTiles(out, c.Tiles);
+			parser.EndParse();
+		}
 
 		if (entity.HasComponent<ScriptComponent>())
 		{
@@ -493,6 +586,15 @@ namespace MoonEngine
 				SpriteComponent* spriteComponent = GetIfExists<SpriteComponent>(entity, deserializedEntity);
 				if (spriteComponent && spriteComponent->HasSpriteSheet())
 					spriteComponent->GenerateSpriteSheet();
+				if (spriteComponent)
+					deserializedEntity.PatchComponent<SpriteComponent>();
+
+				if (GetIfExists<SpriteAnimationComponent>(entity, deserializedEntity))
+					deserializedEntity.PatchComponent<SpriteAnimationComponent>();
+
+				auto tilemapNode = entity[GetTypeName<TilemapComponent>()];
+				if (TilemapComponent* tilemap = GetIfExists<TilemapComponent>(entity, deserializedEntity))
+					DeserializeTiles(tilemapNode, tilemap->Tiles);
 
 				GetIfExists<CameraComponent>(entity, deserializedEntity);
 				GetIfExists<PhysicsBodyComponent>(entity, deserializedEntity);
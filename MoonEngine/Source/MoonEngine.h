@@ -14,10 +14,13 @@
 #include "Event/Action.h"
 
 #include "Renderer/Camera.h"
+#include "Renderer/DebugRenderer.h"
+#include "Renderer/FrameCapture.h"
 #include "Renderer/Framebuffer.h"
 #include "Renderer/Renderer.h"
 #include "Renderer/Shader.h"
 #include "Renderer/Texture.h"
+#include "Renderer/TextureLoader.h"
 
 #include "Utils/Maths.h"
 
@@ -0,0 +1,23 @@
+#include "mpch.h"
+#include "Renderer/ChunkBuffer.h"
+
+#include "Renderer/RendererAPI.h"
+
+namespace MoonEngine
+{
+	void ChunkBuffer::Release()
+	{
+		//Scenes can outlive the renderer
+		RendererAPI* api = RendererAPI::Get();
+		if (!api || !Buffers[0])
+			return;
+
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			api->DeleteBuffer(Buffers[i]);
+			api->DeleteVertexArray(VertexArrays[i]);
+		}
+
+		*this = ChunkBuffer();
+	}
+}
\ No newline at end of file
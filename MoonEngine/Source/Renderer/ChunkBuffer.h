@@ -0,0 +1,18 @@
+#pragma once
+
+namespace MoonEngine
+{
+	//Instance buffer of a retained chunk, kept twice so a rebuild never writes the copy the packet waiting to be drawn reads
+	//Renderer picks the copy and uploads into it, the owner only releases it
+	struct ChunkBuffer
+	{
+		uint32_t Buffers[2] = {};
+		uint32_t VertexArrays[2] = {};
+		uint32_t Current = 0;
+		//Packet the chunk was last rebuilt in, a second rebuild while it is still recording writes the same copy again
+		uint64_t Packet = UINT64_MAX;
+
+		uint32_t GetVertexArray() const { return VertexArrays[Current]; }
+		void Release();
+	};
+}
\ No newline at end of file
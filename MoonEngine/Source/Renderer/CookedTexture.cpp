@@ -0,0 +1,315 @@
+#include "mpch.h"
+#include "Renderer/CookedTexture.h"
+
+#include <stb_image.h>
+
+#include <mutex>
+#include <thread>
+
+namespace MoonEngine
+{
+	//Lives next to Resource/Assets, a changed source gets a new key and simply misses
+	static const char* CookedDirectory = "Resource/Cooked";
+	static constexpr uint32_t CookedMagic = 0x5845544d;
+	static constexpr uint32_t CookedVersion = 2;
+	static constexpr uint64_t FnvOffset = 14695981039346656037ull;
+
+	//Only uncompressed payloads are written for now, the field keeps room for block compressed ones
+	enum class CookedFormat : uint32_t
+	{
+		RGBA8
+	};
+
+	struct CookedHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t Key;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t Levels;
+		CookedFormat Format;
+		AlphaMode Alpha;
+	};
+
+	static uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ data[i]) * 1099511628211ull;
+		return hash;
+	}
+
+	static std::filesystem::path GetCookedPath(uint64_t key)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.mtex", (unsigned long long)key);
+		return std::filesystem::path(CookedDirectory) / name;
+	}
+
+	//Key of a source as it was when last hashed, a source with another size or write time is hashed again
+	struct IndexEntry
+	{
+		uint64_t Size;
+		int64_t WriteTime;
+		uint64_t Key;
+	};
+
+	//Lines of "key size time options path", appended as sources are hashed so the last line of a source wins
+	struct CookedIndex
+	{
+		std::mutex Mutex;
+		bool Loaded = false;
+		std::unordered_map<std::string, IndexEntry> Entries;
+
+		static std::filesystem::path GetPath() { return std::filesystem::path(CookedDirectory) / "Index.txt"; }
+
+		void Load()
+		{
+			Loaded = true;
+			std::ifstream stream(GetPath());
+			std::string line;
+			while (std::getline(stream, line))
+			{
+				std::istringstream fields(line);
+				unsigned long long key = 0, size = 0;
+				long long writeTime = 0;
+				std::string name;
+				if (!(fields >> std::hex >> key >> std::dec >> size >> writeTime))
+					continue;
+
+				fields.ignore(1);
+				std::getline(fields, name);
+				if (!name.empty())
+					Entries[name] = { size, writeTime, key };
+			}
+		}
+
+		bool Find(const std::string& name, uint64_t size, int64_t writeTime, uint64_t& key)
+		{
+			std::scoped_lock<std::mutex> lock(Mutex);
+			if (!Loaded)
+				Load();
+
+			auto it = Entries.find(name);
+			if (it == Entries.end() || it->second.Size != size || it->second.WriteTime != writeTime)
+				return false;
+
+			key = it->second.Key;
+			return true;
+		}
+
+		void Add(const std::string& name, uint64_t size, int64_t writeTime, uint64_t key)
+		{
+			std::scoped_lock<std::mutex> lock(Mutex);
+			if (!Loaded)
+				Load();
+
+			//Same entry again when only the cooked file went missing
+			IndexEntry& entry = Entries[name];
+			if (entry.Size == size && entry.WriteTime == writeTime && entry.Key == key)
+				return;
+			entry = { size, writeTime, key };
+
+			std::error_code error;
+			std::filesystem::create_directories(CookedDirectory, error);
+			std::ofstream stream(GetPath(), std::ios::app);
+			stream << std::hex << key << std::dec << ' ' << size << ' ' << writeTime << ' ' << name << '\n';
+		}
+	};
+
+	static CookedIndex s_Index;
+
+	//Box filter weighted by alpha so transparent texels do not bleed their color into the edges
+	static void Downsample(const CookedLevel& source, uint8_t* target, uint32_t width, uint32_t height)
+	{
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				float color[3] = {};
+				float alpha = 0.0f;
+				float plainColor[3] = {};
+
+				for (uint32_t i = 0; i < 4; i++)
+				{
+					uint32_t sourceX = std::min(x * 2 + (i & 1), source.Width - 1);
+					uint32_t sourceY = std::min(y * 2 + (i >> 1), source.Height - 1);
+					const uint8_t* texel = source.Pixels + (sourceY * source.Width + sourceX) * 4;
+
+					float weight = texel[3] / 255.0f;
+					for (uint32_t c = 0; c < 3; c++)
+					{
+						color[c] += texel[c] * weight;
+						plainColor[c] += texel[c];
+					}
+					alpha += texel[3];
+				}
+
+				uint8_t* result = target + (y * width + x) * 4;
+				float weights = alpha / 255.0f;
+				for (uint32_t c = 0; c < 3; c++)
+					result[c] = (uint8_t)std::min(255.0f, (weights > 0.0f ? color[c] / weights : plainColor[c] / 4.0f) + 0.5f);
+				result[3] = (uint8_t)(alpha / 4.0f + 0.5f);
+			}
+		}
+	}
+
+	static AlphaMode FindAlphaMode(const uint8_t* pixels, uint32_t texelCount)
+	{
+		AlphaMode mode = AlphaMode::Opaque;
+		for (uint32_t i = 0; i < texelCount; i++)
+		{
+			uint8_t alpha = pixels[i * 4 + 3];
+			if (alpha == 0)
+				mode = AlphaMode::Cutout;
+			else if (alpha != 255)
+				return AlphaMode::Translucent;
+		}
+
+		return mode;
+	}
+
+	Unique<CookedTexture> CookedTexture::Open(const std::filesystem::path& source, bool mipmaps, bool topLevelOnly)
+	{
+		std::error_code error;
+		uint64_t sourceSize = std::filesystem::file_size(source, error);
+		if (error)
+			return nullptr;
+
+		int64_t writeTime = (int64_t)std::filesystem::last_write_time(source, error).time_since_epoch().count();
+		uint8_t options = mipmaps ? 1 : 0;
+		std::string indexName = std::to_string(options) + " " + source.lexically_normal().generic_string();
+
+		Unique<CookedTexture> image = MakeUnique<CookedTexture>();
+		uint64_t key = 0;
+		if (!error && s_Index.Find(indexName, sourceSize, writeTime, key) && image->Map(key, topLevelOnly))
+			return image;
+
+		//Unknown or changed source, or its cooked file went away, the key comes from the contents
+		std::ifstream stream(source, std::ios::binary);
+		if (!stream)
+			return nullptr;
+
+		std::vector<uint8_t> contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		key = HashBytes(HashBytes(FnvOffset, contents.data(), contents.size()), &options, 1);
+
+		if (!image->Map(key, topLevelOnly))
+		{
+			if (!image->Cook(contents, key, mipmaps))
+				return nullptr;
+
+			if (topLevelOnly)
+			{
+				image->m_Levels.resize(1);
+				image->m_Memory.resize(image->m_Levels[0].Size);
+				image->m_Size = image->m_Levels[0].Size;
+			}
+		}
+
+		if (!error)
+			s_Index.Add(indexName, sourceSize, writeTime, key);
+		return image;
+	}
+
+	bool CookedTexture::Map(uint64_t key, bool topLevelOnly)
+	{
+		std::filesystem::path path = GetCookedPath(key);
+		if (!m_File.Open(path, topLevelOnly ? sizeof(CookedHeader) : SIZE_MAX) || m_File.GetSize() < sizeof(CookedHeader))
+		{
+			m_File.Close();
+			return false;
+		}
+
+		CookedHeader header = *(const CookedHeader*)m_File.GetData();
+		if (header.Magic != CookedMagic || header.Version != CookedVersion || header.Key != key || header.Format != CookedFormat::RGBA8 || header.Levels == 0)
+		{
+			m_File.Close();
+			return false;
+		}
+
+		//Only the header was mapped to find the size of level 0
+		uint32_t levelCount = topLevelOnly ? 1 : header.Levels;
+		if (topLevelOnly && !m_File.Open(path, sizeof(CookedHeader) + (size_t)header.Width * header.Height * 4))
+			return false;
+
+		SetLevels(m_File.GetData() + sizeof(CookedHeader), header.Width, header.Height, levelCount);
+		m_AlphaMode = header.Alpha;
+		if (sizeof(CookedHeader) + m_Size <= m_File.GetSize())
+			return true;
+
+		m_File.Close();
+		return false;
+	}
+
+	void CookedTexture::SetLevels(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t levelCount)
+	{
+		m_Levels.resize(levelCount);
+		m_Size = 0;
+
+		for (uint32_t i = 0; i < levelCount; i++)
+		{
+			CookedLevel& level = m_Levels[i];
+			level.Width = std::max(width >> i, 1u);
+			level.Height = std::max(height >> i, 1u);
+			level.Size = level.Width * level.Height * 4;
+			level.Pixels = pixels + m_Size;
+			m_Size += level.Size;
+		}
+	}
+
+	bool CookedTexture::Cook(const std::vector<uint8_t>& source, uint64_t key, bool mipmaps)
+	{
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(1);
+		uint8_t* pixels = stbi_load_from_memory(source.data(), (int)source.size(), &width, &height, &channels, 4);
+		if (!pixels)
+			return false;
+
+		uint32_t levelCount = 1;
+		while (mipmaps && (std::max(width, height) >> levelCount) > 0)
+			levelCount++;
+
+		uint32_t size = 0;
+		for (uint32_t i = 0; i < levelCount; i++)
+			size += std::max(width >> i, 1) * std::max(height >> i, 1) * 4;
+
+		m_Memory.resize(size);
+		SetLevels(m_Memory.data(), width, height, levelCount);
+
+		memcpy(m_Memory.data(), pixels, m_Levels[0].Size);
+		stbi_image_free(pixels);
+
+		//Only the top level counts, filtered levels blend cutout edges into partial alpha
+		m_AlphaMode = FindAlphaMode(m_Memory.data(), (uint32_t)width * height);
+
+		for (uint32_t i = 1; i < levelCount; i++)
+			Downsample(m_Levels[i - 1], m_Memory.data() + (m_Levels[i].Pixels - m_Memory.data()), m_Levels[i].Width, m_Levels[i].Height);
+
+		//Written aside and renamed, so a load racing this one never maps a half written file
+		std::error_code error;
+		std::filesystem::create_directories(CookedDirectory, error);
+
+		std::filesystem::path path = GetCookedPath(key);
+		std::filesystem::path temporary = path;
+		temporary += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+		{
+			std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+			if (!stream)
+			{
+				ME_SYS_WAR("Cooked texture could not be written!");
+				return true;
+			}
+
+			CookedHeader header = { CookedMagic, CookedVersion, key, (uint32_t)width, (uint32_t)height, levelCount, CookedFormat::RGBA8, m_AlphaMode };
+			stream.write((const char*)&header, sizeof(header));
+			stream.write((const char*)m_Memory.data(), m_Memory.size());
+		}
+
+		std::filesystem::rename(temporary, path, error);
+		if (error)
+			std::filesystem::remove(temporary, error);
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include "Renderer/Texture.h"
+#include "Utils/MappedFile.h"
+
+namespace MoonEngine
+{
+	struct CookedLevel
+	{
+		uint32_t Width;
+		uint32_t Height;
+		const uint8_t* Pixels;
+		uint32_t Size;
+	};
+
+	//Image in the engine texture format, rgba8 with its whole mip chain, uploaded as is
+	//Sources are cooked on first use into Resource/Cooked keyed by a hash of their contents, later loads only map the cooked file
+	//An index next to the cooked files remembers the key of a source by its path, size and write time, so warm loads never read the source
+	class CookedTexture
+	{
+	public:
+		//Null when the source can not be read or decoded. Safe to call from any thread
+		//topLevelOnly keeps just level 0, for cpu side lookups that never touch the mips
+		static Unique<CookedTexture> Open(const std::filesystem::path& source, bool mipmaps, bool topLevelOnly = false);
+
+		uint32_t GetWidth() const { return m_Levels[0].Width; }
+		uint32_t GetHeight() const { return m_Levels[0].Height; }
+		uint32_t GetLevelCount() const { return (uint32_t)m_Levels.size(); }
+		const CookedLevel& GetLevel(uint32_t level) const { return m_Levels[level]; }
+		//Bytes of every level together
+		uint32_t GetSize() const { return m_Size; }
+		AlphaMode GetAlphaMode() const { return m_AlphaMode; }
+	private:
+		MappedFile m_File;
+		//Holds the pixels instead of the file when the image was cooked by this load
+		std::vector<uint8_t> m_Memory;
+		std::vector<CookedLevel> m_Levels;
+		uint32_t m_Size = 0;
+		AlphaMode m_AlphaMode = AlphaMode::Translucent;
+
+		void SetLevels(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t levelCount);
+		bool Map(uint64_t key, bool topLevelOnly);
+		bool Cook(const std::vector<uint8_t>& source, uint64_t key, bool mipmaps);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "mpch.h"
+#include "Renderer/DebugRenderer.h"
+
+#include "Core/Time.h"
+
+#include "Renderer/FrameCapture.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/RendererAPI.h"
+#include "Renderer/Shader.h"
+#include "Renderer/StreamBuffer.h"
+
+#include "Utils/Maths.h"
+
+namespace MoonEngine
+{
+	//Compact record of a segment, the vertex shader turns it into a quad of Width pixels
+	struct DebugSegment
+	{
+		glm::vec3 Start;
+		uint32_t Color;
+		glm::vec3 End;
+		float Width;
+	};
+
+	struct TimedSegment
+	{
+		DebugSegment Segment;
+		float TimeLeft;
+	};
+
+	const VertexLayout DebugSegmentLayout =
+	{
+		sizeof(DebugSegment), true,
+		{
+			{ AttributeType::Float, 3, offsetof(DebugSegment, Start) },
+			{ AttributeType::UByteNormalized, 4, offsetof(DebugSegment, Color) },
+			{ AttributeType::Float, 3, offsetof(DebugSegment, End) },
+			{ AttributeType::Float, 1, offsetof(DebugSegment, Width) }
+		}
+	};
+
+	const uint32_t MinSegmentCapacity = 1024;
+	//Same ring depth as the quad stream, a flush never waits on the draws of the frame before
+	const uint32_t SegmentStreamRegions = 3;
+	const uint32_t CircleSegments = 32;
+
+	struct DebugData
+	{
+		float LineWidth = 1.0f;
+
+		std::vector<DebugSegment> Segments;
+		std::vector<TimedSegment> TimedSegments;
+
+		//Segments of a flush per region, grows to the biggest flush seen so far and never shrinks
+		Unique<StreamBuffer> Stream;
+		uint32_t VertexArray = 0;
+		uint32_t IndexBuffer = 0;
+		uint32_t Capacity = 0;
+
+		Shared<Shader> LineShader = nullptr;
+
+		//Counters since the last EndFrame
+		uint32_t DrawCalls = 0;
+		uint32_t DrawnSegments = 0;
+		uint32_t ShaderBinds = 0;
+		uint64_t UploadBytes = 0;
+
+		void Submit(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float duration)
+		{
+			DebugSegment segment = { p0, Maths::PackColor(color), p1, LineWidth };
+			if (duration > 0.0f)
+				TimedSegments.push_back({ segment, duration });
+			else
+				Segments.push_back(segment);
+		}
+
+		void Reserve(uint32_t count)
+		{
+			RendererAPI* api = RendererAPI::Get();
+
+			uint32_t capacity = std::max(Capacity, MinSegmentCapacity);
+			while (capacity < count)
+				capacity *= 2;
+
+			//Draws still reading the old ring keep it alive on the gpu side, gl defers the delete until they are done
+			if (Stream)
+				api->DeleteVertexArray(VertexArray);
+
+			Stream = MakeUnique<StreamBuffer>(sizeof(DebugSegment) * capacity, SegmentStreamRegions);
+			VertexArray = api->CreateVertexArray(DebugSegmentLayout, Stream->GetBufferId(), IndexBuffer);
+			Capacity = capacity;
+		}
+	};
+
+	static DebugData* s_Debug;
+
+	void DebugRenderer::Init()
+	{
+		s_Debug = new DebugData();
+
+		const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+		s_Debug->IndexBuffer = RendererAPI::Get()->CreateBuffer(sizeof(indices), indices);
+		s_Debug->Reserve(MinSegmentCapacity);
+
+		s_Debug->LineShader = MakeShared<Shader>("Resource/Shaders/Line.shader");
+	}
+
+	void DebugRenderer::Terminate()
+	{
+		RendererAPI* api = RendererAPI::Get();
+		api->DeleteVertexArray(s_Debug->VertexArray);
+		api->DeleteBuffer(s_Debug->IndexBuffer);
+		s_Debug->Stream = nullptr;
+
+		delete s_Debug;
+		s_Debug = nullptr;
+	}
+
+	void DebugRenderer::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float duration)
+	{
+		s_Debug->Submit(p0, p1, color, duration);
+	}
+
+	void DebugRenderer::DrawRect(const glm::vec3& position, const glm::vec2& scale, const glm::vec4& color, float duration)
+	{
+		const glm::vec3& p0 = glm::vec3(position.x - scale.x * 0.5f, position.y - scale.y * 0.5f, position.z);
+		const glm::vec3& p1 = glm::vec3(position.x + scale.x * 0.5f, position.y - scale.y * 0.5f, position.z);
+		const glm::vec3& p2 = glm::vec3(position.x + scale.x * 0.5f, position.y + scale.y * 0.5f, position.z);
+		const glm::vec3& p3 = glm::vec3(position.x - scale.x * 0.5f, position.y + scale.y * 0.5f, position.z);
+
+		s_Debug->Submit(p0, p1, color, duration);
+		s_Debug->Submit(p1, p2, color, duration);
+		s_Debug->Submit(p2, p3, color, duration);
+		s_Debug->Submit(p3, p0, color, duration);
+	}
+
+	void DebugRenderer::DrawRect(const glm::mat4& transform, const glm::vec4& color, float duration)
+	{
+		const glm::vec3& p0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
+		const glm::vec3& p1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
+		const glm::vec3& p2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
+		const glm::vec3& p3 = transform * glm::vec4(-0.5f,  0.5f, 0.0f, 1.0f);
+
+		s_Debug->Submit(p0, p1, color, duration);
+		s_Debug->Submit(p1, p2, color, duration);
+		s_Debug->Submit(p2, p3, color, duration);
+		s_Debug->Submit(p3, p0, color, duration);
+	}
+
+	void DebugRenderer::DrawCircle(const glm::vec3& center, float radius, const glm::vec4& color, float duration)
+	{
+		glm::vec3 previous = center + glm::vec3(radius, 0.0f, 0.0f);
+		for (uint32_t i = 1; i <= CircleSegments; i++)
+		{
+			float angle = glm::two_pi<float>() * (float)i / (float)CircleSegments;
+			const glm::vec3& next = center + glm::vec3(std::cos(angle) * radius, std::sin(angle) * radius, 0.0f);
+			s_Debug->Submit(previous, next, color, duration);
+			previous = next;
+		}
+	}
+
+	void DebugRenderer::DrawArrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float duration)
+	{
+		s_Debug->Submit(from, to, color, duration);
+
+		glm::vec2 direction = glm::vec2(to - from);
+		float length = glm::length(direction);
+		if (length == 0.0f)
+			return;
+
+		//Head is a fifth of the arrow, its sides open 30 degrees from the shaft
+		direction /= length;
+		const glm::vec2& back = -direction * length * 0.2f;
+		const glm::vec2& side = glm::vec2(-direction.y, direction.x) * length * 0.2f * 0.577f;
+
+		s_Debug->Submit(to, to + glm::vec3(back + side, 0.0f), color, duration);
+		s_Debug->Submit(to, to + glm::vec3(back - side, 0.0f), color, duration);
+	}
+
+	void DebugRenderer::Flush(const glm::mat4& viewProjection)
+	{
+		uint32_t count = (uint32_t)(s_Debug->Segments.size() + s_Debug->TimedSegments.size());
+		if (count == 0)
+			return;
+
+		//The sprite packet still in flight belongs under the lines
+		Renderer::Flush();
+
+		if (count > s_Debug->Capacity)
+			s_Debug->Reserve(count);
+
+		//Both lists are written back to back straight into the mapped region
+		uint32_t offset = 0;
+		DebugSegment* segments = (DebugSegment*)s_Debug->Stream->Allocate(sizeof(DebugSegment) * count, sizeof(DebugSegment), offset);
+		std::copy(s_Debug->Segments.begin(), s_Debug->Segments.end(), segments);
+		DebugSegment* timedSegments = segments + s_Debug->Segments.size();
+		for (const TimedSegment& timed : s_Debug->TimedSegments)
+			*timedSegments++ = timed.Segment;
+		s_Debug->UploadBytes += sizeof(DebugSegment) * count;
+
+		//Recorded as drawn, timed shapes replay as plain lines in every frame they were alive
+		if (FrameCapture::IsCapturing())
+		{
+			for (uint32_t i = 0; i < count; i++)
+				FrameCapture::RecordLine(segments[i].Start, segments[i].End, segments[i].Color, segments[i].Width);
+			FrameCapture::RecordLineFlush(viewProjection);
+		}
+
+		RendererAPI* api = RendererAPI::Get();
+
+		//Widths are in pixels of the target drawn into, the frame uniforms carry its size
+		Renderer::SetFrameUniforms(viewProjection);
+		s_Debug->LineShader->Bind();
+		s_Debug->ShaderBinds++;
+
+		api->DrawIndexedInstanced(s_Debug->VertexArray, 6, count, offset / sizeof(DebugSegment));
+		s_Debug->Stream->Fence();
+		s_Debug->DrawCalls++;
+		s_Debug->DrawnSegments += count;
+
+		s_Debug->Segments.clear();
+	}
+
+	void DebugRenderer::Clear()
+	{
+		s_Debug->Segments.clear();
+		s_Debug->TimedSegments.clear();
+	}
+
+	void DebugRenderer::SetLineWidth(float width)
+	{
+		s_Debug->LineWidth = width;
+	}
+
+	void DebugRenderer::EndFrame(RendererStats& frame)
+	{
+		//Shapes no view flushed this frame would pile up otherwise
+		s_Debug->Segments.clear();
+
+		float deltaTime = Time::DeltaTime();
+		std::vector<TimedSegment>& timedSegments = s_Debug->TimedSegments;
+		for (TimedSegment& timed : timedSegments)
+			timed.TimeLeft -= deltaTime;
+
+		timedSegments.erase(std::remove_if(timedSegments.begin(), timedSegments.end(), [](const TimedSegment& timed) { return timed.TimeLeft <= 0.0f; }), timedSegments.end());
+
+		frame.DrawCalls += s_Debug->DrawCalls;
+		frame.Lines += s_Debug->DrawnSegments;
+		frame.ShaderBinds += s_Debug->ShaderBinds;
+		frame.UploadBytes += s_Debug->UploadBytes;
+
+		s_Debug->DrawCalls = 0;
+		s_Debug->DrawnSegments = 0;
+		s_Debug->ShaderBinds = 0;
+		s_Debug->UploadBytes = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace MoonEngine
+{
+	struct RendererStats;
+
+	//Lines, rects, circles and arrows for gizmos and gameplay debugging, recorded apart from the sprite packets
+	//Every segment is one instance widened to a screen space quad, so it has its own buffer and flush
+	class DebugRenderer
+	{
+	public:
+		//A duration in seconds keeps the shape for several frames, every Flush draws it until it runs out
+		static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float duration = 0.0f);
+		static void DrawRect(const glm::vec3& position, const glm::vec2& scale, const glm::vec4& color, float duration = 0.0f);
+		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, float duration = 0.0f);
+		static void DrawCircle(const glm::vec3& center, float radius, const glm::vec4& color, float duration = 0.0f);
+		static void DrawArrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float duration = 0.0f);
+
+		//Draws the queued shapes into the bound target on top of the sprites ended so far
+		//Shapes without a duration are dropped afterwards, the rest wait for the next Flush
+		static void Flush(const glm::mat4& viewProjection);
+		//Drops the timed shapes too
+		static void Clear();
+
+		//Width in pixels of the shapes submitted after the call
+		static void SetLineWidth(float width);
+	private:
+		static void Init();
+		static void Terminate();
+		//Ages the timed shapes and adds the counters of the frame
+		static void EndFrame(RendererStats& frame);
+
+		friend class Renderer;
+	};
+}
\ No newline at end of file
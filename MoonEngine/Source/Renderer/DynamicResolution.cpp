@@ -0,0 +1,61 @@
+#include "mpch.h"
+#include "Renderer/DynamicResolution.h"
+
+namespace MoonEngine
+{
+	//Weight of a new frame in the smoothed times
+	const float Smoothing = 0.1f;
+	const uint32_t CooldownFrames = 30;
+	//Scaling up waits until the bigger target is predicted to stay this far under the target time, so the scale does not bounce
+	const float UpscaleHeadroom = 0.8f;
+	const float UpscaleStep = 0.05f;
+
+	void DynamicResolution::Update(float cpuTime, float gpuTime)
+	{
+		float minScale = std::clamp(MinScale, 0.1f, 1.0f);
+		float maxScale = std::clamp(MaxScale, minScale, 1.0f);
+
+		if (!Enabled || gpuTime <= 0.0f)
+		{
+			m_Scale = std::clamp(m_Scale, minScale, maxScale);
+			return;
+		}
+
+		m_CpuTime = m_CpuTime > 0.0f ? glm::mix(m_CpuTime, cpuTime, Smoothing) : cpuTime;
+		m_GpuTime = m_GpuTime > 0.0f ? glm::mix(m_GpuTime, gpuTime, Smoothing) : gpuTime;
+
+		if (m_Cooldown > 0)
+		{
+			m_Cooldown--;
+			return;
+		}
+
+		float scale = m_Scale;
+		if (m_GpuTime > TargetFrameTime)
+		{
+			//Gpu time follows the pixel count, which goes with the square of the scale
+			scale = m_Scale * std::sqrt(TargetFrameTime * UpscaleHeadroom / m_GpuTime);
+		}
+		else
+		{
+			//A late cpu is no reason to keep the fill rate down, the prediction alone guards the gpu
+			float next = m_Scale + UpscaleStep;
+			float predicted = m_GpuTime * (next * next) / (m_Scale * m_Scale);
+			if (predicted < TargetFrameTime * UpscaleHeadroom)
+				scale = next;
+		}
+
+		scale = std::clamp(scale, minScale, maxScale);
+		if (std::abs(scale - m_Scale) < 0.01f)
+			return;
+
+		m_Scale = scale;
+		m_Cooldown = CooldownFrames;
+	}
+
+	glm::uvec2 DynamicResolution::GetRenderSize(const glm::vec2& size) const
+	{
+		float scale = GetScale();
+		return { std::max((uint32_t)(size.x * scale), 1u), std::max((uint32_t)(size.y * scale), 1u) };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace MoonEngine
+{
+	//Scales a render target to hold a frame time. Gpu time is the only signal since the scale only moves fill cost,
+	//cpu time is smoothed alongside to tell when the frame is late for reasons the scale cannot fix
+	class DynamicResolution
+	{
+	public:
+		bool Enabled = false;
+		//Bounds of the scale per axis
+		float MinScale = 0.5f;
+		float MaxScale = 1.0f;
+		//Milliseconds
+		float TargetFrameTime = 1000.0f / 60.0f;
+
+		//Takes the times of the last frame in milliseconds, a gpu time of 0 means nothing was measured yet.
+		//Cpu time should leave out present and the vsync wait
+		void Update(float cpuTime, float gpuTime);
+
+		float GetScale() const { return Enabled ? m_Scale : 1.0f; }
+		float GetCpuTime() const { return m_CpuTime; }
+		float GetGpuTime() const { return m_GpuTime; }
+		//Size to render at for a target shown at the given size
+		glm::uvec2 GetRenderSize(const glm::vec2& size) const;
+	private:
+		float m_Scale = 1.0f;
+		float m_CpuTime = 0.0f;
+		float m_GpuTime = 0.0f;
+		//Frames left before the scale may change again, gpu times arrive a few frames late
+		uint32_t m_Cooldown = 0;
+	};
+}
\ No newline at end of file
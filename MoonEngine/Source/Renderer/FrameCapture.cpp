@@ -0,0 +1,465 @@
+#include "mpch.h"
+#include "Renderer/FrameCapture.h"
+
+#include "Renderer/DebugRenderer.h"
+#include "Renderer/Framebuffer.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/RendererAPI.h"
+#include "Renderer/Texture.h"
+
+#include <chrono>
+
+namespace MoonEngine
+{
+	static constexpr uint32_t CaptureMagic = 0x5041434d;
+	static constexpr uint32_t CaptureVersion = 1;
+
+	//File layout: header, texture paths, then the commands of every frame back to back
+	struct CaptureHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t FrameCount;
+		uint32_t TextureCount;
+		uint64_t CommandBytes;
+	};
+
+	enum class CaptureCommand : uint8_t
+	{
+		Begin,
+		Quad,
+		End,
+		Line,
+		LineFlush,
+		EndFrame
+	};
+
+	struct CapturedBegin
+	{
+		glm::mat4 ViewProjection;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t Clear;
+		uint32_t NameLength;
+	};
+
+	struct CapturedQuad
+	{
+		glm::vec3 AxisX;
+		glm::vec3 AxisY;
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec4 TexRect;
+		glm::vec2 Tiling;
+		int32_t Layer;
+		//Index into the path table, 0 is no texture
+		uint32_t Texture;
+	};
+
+	struct CapturedLine
+	{
+		glm::vec3 P0;
+		uint32_t Color;
+		glm::vec3 P1;
+		float Width;
+	};
+
+	struct CaptureData
+	{
+		std::string Path;
+		uint32_t FramesLeft = 0;
+		uint32_t FrameCount = 0;
+		bool Armed = false;
+
+		std::vector<uint8_t> Commands;
+		std::vector<std::string> TexturePaths;
+		std::unordered_map<const Texture*, uint32_t> TextureIndices;
+
+		template<typename T>
+		void Write(CaptureCommand command, const T& record)
+		{
+			Commands.push_back((uint8_t)command);
+			Write(&record, sizeof(T));
+		}
+
+		void Write(const void* data, size_t size)
+		{
+			const uint8_t* bytes = (const uint8_t*)data;
+			Commands.insert(Commands.end(), bytes, bytes + size);
+		}
+
+		uint32_t GetTextureIndex(const Shared<Texture>& texture)
+		{
+			if (!texture || texture->GetPath().empty())
+				return 0;
+
+			auto it = TextureIndices.find(texture.get());
+			if (it != TextureIndices.end())
+				return it->second;
+
+			TexturePaths.push_back(texture->GetPath().string());
+			uint32_t index = (uint32_t)TexturePaths.size();
+			TextureIndices[texture.get()] = index;
+			return index;
+		}
+
+		void Reset()
+		{
+			Commands.clear();
+			TexturePaths.clear();
+			TextureIndices.clear();
+			FrameCount = 0;
+		}
+	};
+
+	static CaptureData s_Capture;
+
+	//Walks the commands once before anything is drawn, so a truncated or corrupted capture never reads past its buffer
+	static bool ValidateCommands(const std::vector<uint8_t>& commands, uint32_t textureCount)
+	{
+		const uint8_t* cursor = commands.data();
+		const uint8_t* end = cursor + commands.size();
+
+		auto skip = [&](size_t size)
+		{
+			if ((size_t)(end - cursor) < size)
+				return false;
+			cursor += size;
+			return true;
+		};
+
+		while (cursor < end)
+		{
+			switch ((CaptureCommand)*cursor++)
+			{
+				case CaptureCommand::Begin:
+				{
+					CapturedBegin begin;
+					if ((size_t)(end - cursor) < sizeof(begin))
+						return false;
+					memcpy(&begin, cursor, sizeof(begin));
+					cursor += sizeof(begin);
+					if (begin.Width == 0 || begin.Height == 0 || !skip(begin.NameLength))
+						return false;
+					break;
+				}
+				case CaptureCommand::Quad:
+				{
+					CapturedQuad quad;
+					if ((size_t)(end - cursor) < sizeof(quad))
+						return false;
+					memcpy(&quad, cursor, sizeof(quad));
+					if (quad.Texture > textureCount)
+						return false;
+					cursor += sizeof(quad);
+					break;
+				}
+				case CaptureCommand::End:
+				case CaptureCommand::EndFrame:
+					break;
+				case CaptureCommand::Line:
+					if (!skip(sizeof(CapturedLine)))
+						return false;
+					break;
+				case CaptureCommand::LineFlush:
+					if (!skip(sizeof(glm::mat4)))
+						return false;
+					break;
+				default:
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void FrameCapture::Start(const std::string& path, uint32_t frameCount)
+	{
+		if (s_Capturing || s_Capture.Armed)
+		{
+			ME_SYS_WAR("A frame capture is already running!");
+			return;
+		}
+
+		s_Capture.Reset();
+		s_Capture.Path = path;
+		s_Capture.FramesLeft = std::max(frameCount, 1u);
+		s_Capture.Armed = true;
+	}
+
+	void FrameCapture::RecordBegin(const glm::mat4& viewProjection, const char* pass, bool clear)
+	{
+		const RenderTarget& target = RendererAPI::Get()->GetTarget();
+
+		CapturedBegin begin;
+		begin.ViewProjection = viewProjection;
+		begin.Width = (uint32_t)std::max(target.Viewport[2], 1);
+		begin.Height = (uint32_t)std::max(target.Viewport[3], 1);
+		begin.Clear = clear ? 1 : 0;
+		begin.NameLength = (uint32_t)strlen(pass);
+
+		s_Capture.Write(CaptureCommand::Begin, begin);
+		s_Capture.Write(pass, begin.NameLength);
+	}
+
+	void FrameCapture::RecordQuad(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, const glm::vec4& texRect, int layer, const glm::vec2& tiling)
+	{
+		CapturedQuad quad;
+		quad.AxisX = transform[0];
+		quad.AxisY = transform[1];
+		quad.Position = transform[3];
+		quad.Color = color;
+		quad.TexRect = texRect;
+		quad.Tiling = tiling;
+		quad.Layer = layer;
+		quad.Texture = s_Capture.GetTextureIndex(texture);
+
+		s_Capture.Write(CaptureCommand::Quad, quad);
+	}
+
+	void FrameCapture::RecordEnd()
+	{
+		s_Capture.Commands.push_back((uint8_t)CaptureCommand::End);
+	}
+
+	void FrameCapture::RecordLine(const glm::vec3& p0, const glm::vec3& p1, uint32_t color, float width)
+	{
+		s_Capture.Write(CaptureCommand::Line, CapturedLine{ p0, color, p1, width });
+	}
+
+	void FrameCapture::RecordLineFlush(const glm::mat4& viewProjection)
+	{
+		s_Capture.Write(CaptureCommand::LineFlush, viewProjection);
+	}
+
+	void FrameCapture::EndFrame()
+	{
+		if (s_Capture.Armed)
+		{
+			s_Capture.Armed = false;
+			s_Capturing = true;
+			return;
+		}
+
+		if (!s_Capturing)
+			return;
+
+		s_Capture.Commands.push_back((uint8_t)CaptureCommand::EndFrame);
+		s_Capture.FrameCount++;
+
+		if (--s_Capture.FramesLeft > 0)
+			return;
+
+		s_Capturing = false;
+
+		std::ofstream stream(s_Capture.Path, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			ME_SYS_WAR("Frame capture could not write {0}", s_Capture.Path);
+			s_Capture.Reset();
+			return;
+		}
+
+		CaptureHeader header = { CaptureMagic, CaptureVersion, s_Capture.FrameCount, (uint32_t)s_Capture.TexturePaths.size(), s_Capture.Commands.size() };
+		stream.write((const char*)&header, sizeof(header));
+
+		for (const std::string& texturePath : s_Capture.TexturePaths)
+		{
+			uint32_t length = (uint32_t)texturePath.size();
+			stream.write((const char*)&length, sizeof(length));
+			stream.write(texturePath.data(), length);
+		}
+
+		stream.write((const char*)s_Capture.Commands.data(), s_Capture.Commands.size());
+
+		ME_SYS_SUC("Captured {0} frames to {1} ({2:.1f} KB)", s_Capture.FrameCount, s_Capture.Path, s_Capture.Commands.size() / 1024.0f);
+		s_Capture.Reset();
+	}
+
+	static glm::vec4 UnpackColor(uint32_t color)
+	{
+		return glm::vec4(color & 0xff, (color >> 8) & 0xff, (color >> 16) & 0xff, color >> 24) / 255.0f;
+	}
+
+	bool FrameCapture::Replay(const std::string& path, uint32_t loops, FrameReplayStats& stats)
+	{
+		if (s_Capturing || s_Capture.Armed)
+		{
+			ME_SYS_WAR("Cannot replay while a frame capture is running!");
+			return false;
+		}
+
+		std::error_code error;
+		uint64_t fileSize = std::filesystem::file_size(path, error);
+		std::ifstream stream(path, std::ios::binary);
+		CaptureHeader header = {};
+		stream.read((char*)&header, sizeof(header));
+		if (error || !stream || header.Magic != CaptureMagic || header.Version != CaptureVersion)
+		{
+			ME_SYS_WAR("{0} is not a frame capture of this version!", path);
+			return false;
+		}
+
+		//Sizes in the file are only trusted as far as the file reaches, every path takes at least its length
+		auto remaining = [&]() { return fileSize - std::min(fileSize, (uint64_t)stream.tellg()); };
+		if ((uint64_t)header.TextureCount * sizeof(uint32_t) > remaining())
+		{
+			ME_SYS_WAR("Frame capture {0} is truncated!", path);
+			return false;
+		}
+
+		//Loaded synchronously, streaming them in would replay the first loops with white placeholders
+		std::vector<Shared<Texture>> textures(header.TextureCount + 1);
+		for (uint32_t i = 1; i <= header.TextureCount; i++)
+		{
+			uint32_t length = 0;
+			stream.read((char*)&length, sizeof(length));
+			if (!stream || length > remaining())
+			{
+				ME_SYS_WAR("Frame capture {0} is truncated!", path);
+				return false;
+			}
+
+			std::string texturePath(length, '\0');
+			stream.read(texturePath.data(), length);
+
+			if (std::filesystem::exists(texturePath))
+				textures[i] = MakeShared<Texture>(texturePath);
+			else
+				ME_SYS_WAR("Replayed texture {0} is missing, drawing it white", texturePath);
+		}
+
+		if (!stream || header.CommandBytes > remaining())
+		{
+			ME_SYS_WAR("Frame capture {0} is truncated!", path);
+			return false;
+		}
+
+		std::vector<uint8_t> commands(header.CommandBytes);
+		stream.read((char*)commands.data(), commands.size());
+		if (!stream || !ValidateCommands(commands, header.TextureCount))
+		{
+			ME_SYS_WAR("Frame capture {0} is corrupted!", path);
+			return false;
+		}
+
+		//The first pass of the capture sets the size, later passes only grow it
+		Renderer::Flush();
+		RendererAPI* api = RendererAPI::Get();
+		RenderTarget previousTarget = api->GetTarget();
+		Framebuffer framebuffer({ {FramebufferTextureFormat::RGBA8}, {FramebufferTextureFormat::DEPTH} });
+
+		stats = FrameReplayStats();
+		float gpuTime = 0.0f;
+		//Passes of the application keep their last timings, only the replayed ones are summed
+		std::vector<std::string> passes;
+
+		for (uint32_t loop = 0; loop < loops; loop++)
+		{
+			const uint8_t* cursor = commands.data();
+			const uint8_t* end = cursor + commands.size();
+			auto start = std::chrono::steady_clock::now();
+
+			auto read = [&](auto& record)
+			{
+				memcpy(&record, cursor, sizeof(record));
+				cursor += sizeof(record);
+			};
+
+			while (cursor < end)
+			{
+				switch ((CaptureCommand)*cursor++)
+				{
+					case CaptureCommand::Begin:
+					{
+						CapturedBegin begin;
+						read(begin);
+						std::string pass((const char*)cursor, begin.NameLength);
+						cursor += begin.NameLength;
+						if (std::find(passes.begin(), passes.end(), pass) == passes.end())
+							passes.push_back(pass);
+
+						framebuffer.Resize(begin.Width, begin.Height);
+						framebuffer.Bind();
+						Renderer::Begin(begin.ViewProjection, pass.c_str(), begin.Clear != 0);
+						break;
+					}
+					case CaptureCommand::Quad:
+					{
+						CapturedQuad quad;
+						read(quad);
+
+						glm::mat4 transform = glm::mat4(1.0f);
+						transform[0] = glm::vec4(quad.AxisX, 0.0f);
+						transform[1] = glm::vec4(quad.AxisY, 0.0f);
+						transform[3] = glm::vec4(quad.Position, 1.0f);
+						Renderer::DrawQuad(transform, quad.Color, textures[quad.Texture], quad.TexRect, quad.Layer, quad.Tiling);
+						break;
+					}
+					case CaptureCommand::End:
+						Renderer::End();
+						break;
+					case CaptureCommand::Line:
+					{
+						CapturedLine line;
+						read(line);
+						DebugRenderer::SetLineWidth(line.Width);
+						DebugRenderer::DrawLine(line.P0, line.P1, UnpackColor(line.Color));
+						break;
+					}
+					case CaptureCommand::LineFlush:
+					{
+						glm::mat4 viewProjection;
+						read(viewProjection);
+						DebugRenderer::Flush(viewProjection);
+						break;
+					}
+					case CaptureCommand::EndFrame:
+					{
+						auto submitted = std::chrono::steady_clock::now();
+						Renderer::EndFrame();
+						auto finished = std::chrono::steady_clock::now();
+
+						const RendererStats& frame = Renderer::GetStats();
+						stats.Frames++;
+						stats.Quads += frame.Quads;
+						stats.Lines += frame.Lines;
+						stats.DrawCalls += frame.DrawCalls;
+						stats.SubmitTime += std::chrono::duration<float, std::milli>(submitted - start).count();
+						stats.EndFrameTime += std::chrono::duration<float, std::milli>(finished - submitted).count();
+						stats.WriteTime += frame.WriteTime;
+						for (const RenderPassStats& pass : frame.Passes)
+							if (std::find(passes.begin(), passes.end(), pass.Name) != passes.end())
+								gpuTime += pass.GpuTime;
+
+						start = std::chrono::steady_clock::now();
+						break;
+					}
+					default:
+						ME_SYS_WAR("Frame capture {0} is corrupted!", path);
+						cursor = end;
+						loop = loops;
+						break;
+				}
+			}
+		}
+
+		Renderer::Flush();
+		api->SetTarget(previousTarget);
+		DebugRenderer::SetLineWidth(1.0f);
+
+		if (stats.Frames > 0)
+		{
+			float frames = (float)stats.Frames;
+			stats.Quads = (uint32_t)(stats.Quads / frames);
+			stats.Lines = (uint32_t)(stats.Lines / frames);
+			stats.DrawCalls = (uint32_t)(stats.DrawCalls / frames);
+			stats.SubmitTime /= frames;
+			stats.EndFrameTime /= frames;
+			stats.WriteTime /= frames;
+			stats.GpuTime = gpuTime / frames;
+		}
+
+		return stats.Frames > 0;
+	}
+}
\ No newline at end of file
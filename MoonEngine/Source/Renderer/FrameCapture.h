@@ -0,0 +1,50 @@
+#pragma once
+
+namespace MoonEngine
+{
+	class Texture;
+
+	//Averages per replayed frame, times in milliseconds
+	struct FrameReplayStats
+	{
+		uint32_t Frames = 0;
+		uint32_t Quads = 0;
+		uint32_t Lines = 0;
+		uint32_t DrawCalls = 0;
+		//Re-submitting the recorded calls, including the Ends that hand packets to the render thread
+		float SubmitTime = 0.0f;
+		//Renderer::EndFrame, waiting for the last packet and issuing its draws
+		float EndFrameTime = 0.0f;
+		//Writing streamed quads, the render thread and its workers together
+		float WriteTime = 0.0f;
+		//Sum of the pass timers, zero on the null backend. Results arrive a few frames late, short replays under report
+		float GpuTime = 0.0f;
+	};
+
+	//Records what the renderer is asked to draw, so a stutter from the field can be replayed and profiled locally
+	//Textures are stored by path and replay as white without one. Static batches and tilemaps are retained on the gpu and not recorded
+	class FrameCapture
+	{
+	public:
+		//Records the frames after the current one and writes them to path once the last one ends
+		static void Start(const std::string& path, uint32_t frameCount = 1);
+		static bool IsCapturing() { return s_Capturing; }
+
+		//Submits every frame of the capture loops times through the renderer, gpu backends draw into an offscreen target
+		static bool Replay(const std::string& path, uint32_t loops, FrameReplayStats& stats);
+	private:
+		inline static bool s_Capturing = false;
+
+		static void RecordBegin(const glm::mat4& viewProjection, const char* pass, bool clear);
+		static void RecordQuad(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, const glm::vec4& texRect, int layer, const glm::vec2& tiling);
+		static void RecordEnd();
+		//Color packed as the DebugRenderer stores it
+		static void RecordLine(const glm::vec3& p0, const glm::vec3& p1, uint32_t color, float width);
+		static void RecordLineFlush(const glm::mat4& viewProjection);
+		//Starts and finishes captures on frame boundaries
+		static void EndFrame();
+
+		friend class Renderer;
+		friend class DebugRenderer;
+	};
+}
\ No newline at end of file
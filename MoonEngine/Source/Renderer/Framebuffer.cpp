@@ -2,6 +2,9 @@
 #include "Renderer/Framebuffer.h"
 
 #include "Core/Debug.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/RendererAPI.h"
+#include "Renderer/RenderTargetPool.h"
 
 #include <glad/glad.h>
 
@@ -13,70 +16,53 @@ namespace MoonEngine
 		Invalidate();
 	}
 
-	static void GenerateTexture(uint32_t& textureId, uint32_t index, GLenum internalFormat, GLenum format, uint32_t width, uint32_t height)
+	void Framebuffer::Invalidate()
 	{
-		glCreateTextures(GL_TEXTURE_2D, 1, &textureId);
-		glBindTexture(GL_TEXTURE_2D, textureId);
-
-		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, NULL);
+		if (RendererAPI::IsNull())
+			return;
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		//Queued draws still sample or target the attachments about to be handed back
+		Renderer::Flush();
 
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + index, GL_TEXTURE_2D, textureId, 0);
-	}
-
-	void Framebuffer::Invalidate()
-	{
-		if (m_FramebufferId)
-			Destroy();
+		if (!m_FramebufferId)
+			glCreateFramebuffers(1, &m_FramebufferId);
 
-		glCreateFramebuffers(1, &m_FramebufferId);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferId);
+		//Attachments can come from free textures of different sizes, the framebuffer can only use the area they all cover
+		m_TextureWidth = UINT32_MAX;
+		m_TextureHeight = UINT32_MAX;
 
-		if (m_Props.ColorAttachments.size())
+		auto acquire = [&](FramebufferTextureProps& attachment, uint32_t attachmentPoint)
 		{
-			uint32_t index = 0;
-			for (auto& format : m_Props.ColorAttachments)
-			{
-				switch (format.TextureFormat)
-				{
-					case FramebufferTextureFormat::RGBA8:
-						GenerateTexture(format.ID, index++, GL_RGBA8, GL_RGBA, m_Width, m_Height);
-						break;
-					case FramebufferTextureFormat::RED_INTEGER:
-						GenerateTexture(format.ID, index++, GL_R32I, GL_RED_INTEGER, m_Width, m_Height);
-						break;
-				}
-			}
-		}
+			uint32_t width = m_Width;
+			uint32_t height = m_Height;
+			attachment.ID = RenderTargetPool::Acquire(attachment.TextureFormat, width, height, attachment.ID);
+			glNamedFramebufferTexture(m_FramebufferId, attachmentPoint, attachment.ID, 0);
 
-		if (m_Props.DepthAttachment.TextureFormat == FramebufferTextureFormat::DEPTH)
-		{
-			auto& depthAttachment = m_Props.DepthAttachment;
-			glCreateTextures(GL_TEXTURE_2D, 1, &depthAttachment.ID);
-			glBindTexture(GL_TEXTURE_2D, depthAttachment.ID);
+			m_TextureWidth = std::min(m_TextureWidth, width);
+			m_TextureHeight = std::min(m_TextureHeight, height);
+		};
 
-			glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, m_Width, m_Height);
+		uint32_t index = 0;
+		for (auto& attachment : m_Props.ColorAttachments)
+			acquire(attachment, GL_COLOR_ATTACHMENT0 + index++);
 
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthAttachment.ID, 0);
-		}
+		if (m_Props.DepthAttachment.TextureFormat == FramebufferTextureFormat::DEPTH)
+			acquire(m_Props.DepthAttachment, GL_DEPTH_STENCIL_ATTACHMENT);
 
 		int32_t colorAttachmentsSize = m_Props.ColorAttachments.size();
 		if (colorAttachmentsSize > 1 && colorAttachmentsSize < 4)
 		{
 			GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
-			glDrawBuffers(colorAttachmentsSize, buffers);
+			glNamedFramebufferDrawBuffers(m_FramebufferId, colorAttachmentsSize, buffers);
 		}
-
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
 	void Framebuffer::ClearColorAttachment(uint32_t attachmentIndex, void* clearData)
 	{
+		Renderer::Flush();
+		if (RendererAPI::IsNull())
+			return;
+
 		auto& attachment = m_Props.ColorAttachments[attachmentIndex];
 
 		switch (attachment.TextureFormat)
@@ -92,9 +78,10 @@ namespace MoonEngine
 
 	int Framebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
 	{
-		if (attachmentIndex >= m_Props.ColorAttachments.size())
+		if (attachmentIndex >= m_Props.ColorAttachments.size() || RendererAPI::IsNull())
 			return -1;
 
+		Renderer::Flush();
 		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
 		int pixelData;
 		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
@@ -109,32 +96,46 @@ namespace MoonEngine
 
 		m_Width = width;
 		m_Height = height;
-		Invalidate();
+
+		if (width > m_TextureWidth || height > m_TextureHeight)
+			Invalidate();
 	}
 
 	void Framebuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferId);
-		glViewport(0, 0, m_Width, m_Height);
+		bool depth = m_Props.DepthAttachment.TextureFormat == FramebufferTextureFormat::DEPTH;
+		RendererAPI::Get()->SetTarget({ (int32_t)m_FramebufferId, { 0, 0, (int32_t)m_Width, (int32_t)m_Height }, depth });
 	}
 
 	void Framebuffer::Unbind()
 	{
+		if (RendererAPI::IsNull())
+			return;
+
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	}
 
 	void Framebuffer::Destroy()
 	{
+		//Draws still queued for this framebuffer have to land before its attachments go away
+		Renderer::Flush();
+		if (RendererAPI::IsNull())
+			return;
+
 		glDeleteFramebuffers(1, &m_FramebufferId);
+		m_FramebufferId = 0;
+
+		for (auto& attachment : m_Props.ColorAttachments)
+		{
+			RenderTargetPool::Release(attachment.ID);
+			attachment.ID = 0;
+		}
 
-		if (m_Props.ColorAttachments.size())
-			for (auto& format : m_Props.ColorAttachments)
-			{
-				glDeleteTextures(1, &format.ID);
-			}
+		RenderTargetPool::Release(m_Props.DepthAttachment.ID);
+		m_Props.DepthAttachment.ID = 0;
 
-		if (m_Props.DepthAttachment.TextureFormat == FramebufferTextureFormat::DEPTH)
-			glDeleteTextures(1, &m_Props.DepthAttachment.ID);
+		m_TextureWidth = 0;
+		m_TextureHeight = 0;
 	}
 
 	Framebuffer::~Framebuffer()
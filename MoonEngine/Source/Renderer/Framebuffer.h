@@ -54,6 +54,7 @@ namespace MoonEngine
 		~Framebuffer();
 
 		void Invalidate();
+		//Only replaces the attachments when the size outgrows them, smaller sizes render into a corner of the textures
 		void Resize(uint32_t width, uint32_t height);
 
 		void Bind();
@@ -63,6 +64,8 @@ namespace MoonEngine
 		uint32_t GetTexID(uint32_t attachmentIndex = 0) const { return m_Props.ColorAttachments[attachmentIndex].ID; }
 		uint32_t GetHeight() const { return m_Height; };
 		uint32_t GetWidth() const { return m_Width; };
+		//Uv of the far corner of the rendered area, the attachments are usually larger than the framebuffer
+		glm::vec2 GetTexCoordMax() const { return { m_Width / (float)std::max(m_TextureWidth, 1u), m_Height / (float)std::max(m_TextureHeight, 1u) }; }
 
 		void ClearColorAttachment(uint32_t attachmentIndex, void* clearData);
 		int ReadPixel(uint32_t index, int x, int y);
@@ -72,6 +75,9 @@ namespace MoonEngine
 		uint32_t redId = 0;
 		uint32_t m_Width = 0;
 		uint32_t m_Height = 0;
+		//Size of the pooled attachments
+		uint32_t m_TextureWidth = 0;
+		uint32_t m_TextureHeight = 0;
 
 		FramebufferProps m_Props;
 	};
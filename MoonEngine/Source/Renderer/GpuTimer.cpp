@@ -0,0 +1,66 @@
+#include "mpch.h"
+#include "Renderer/GpuTimer.h"
+
+#include "Renderer/RendererAPI.h"
+
+#include <glad/glad.h>
+
+namespace MoonEngine
+{
+	GpuTimer::GpuTimer(uint32_t queryCount)
+	{
+		m_Queries.resize(queryCount);
+		if (RendererAPI::IsNull())
+			return;
+
+		for (TimerQuery& query : m_Queries)
+			glGenQueries(1, &query.Id);
+	}
+
+	bool GpuTimer::Begin(uint32_t pass)
+	{
+		TimerQuery& query = m_Queries[m_Head];
+		if (query.Pending || RendererAPI::IsNull())
+			return false;
+
+		query.Pass = pass;
+		query.Pending = true;
+		glBeginQuery(GL_TIME_ELAPSED, query.Id);
+		return true;
+	}
+
+	void GpuTimer::End()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_Head = (m_Head + 1) % (uint32_t)m_Queries.size();
+	}
+
+	void GpuTimer::Collect(const std::function<void(uint32_t, float)>& func)
+	{
+		while (m_Queries[m_Tail].Pending)
+		{
+			TimerQuery& query = m_Queries[m_Tail];
+
+			GLint available = 0;
+			glGetQueryObjectiv(query.Id, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				break;
+
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(query.Id, GL_QUERY_RESULT, &elapsed);
+			query.Pending = false;
+			m_Tail = (m_Tail + 1) % (uint32_t)m_Queries.size();
+
+			func(query.Pass, (float)((double)elapsed / 1000000.0));
+		}
+	}
+
+	GpuTimer::~GpuTimer()
+	{
+		if (RendererAPI::IsNull())
+			return;
+
+		for (TimerQuery& query : m_Queries)
+			glDeleteQueries(1, &query.Id);
+	}
+}
\ No newline at end of file
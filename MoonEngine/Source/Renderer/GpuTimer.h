@@ -0,0 +1,33 @@
+#pragma once
+
+namespace MoonEngine
+{
+	//Ring of GL_TIME_ELAPSED queries. Results are only read once the gpu has them, so timing never stalls the cpu
+	//Passes that start while every query is still in flight are skipped
+	class GpuTimer
+	{
+	public:
+		GpuTimer(uint32_t queryCount = 32);
+		GpuTimer(const GpuTimer&) = delete;
+		GpuTimer& operator=(const GpuTimer&) = delete;
+		~GpuTimer();
+
+		//Returns false when no query is free, End must only be called after a successful Begin
+		bool Begin(uint32_t pass);
+		void End();
+
+		//Calls func(pass, milliseconds) for every finished query, oldest first
+		void Collect(const std::function<void(uint32_t, float)>& func);
+	private:
+		struct TimerQuery
+		{
+			uint32_t Id = 0;
+			uint32_t Pass = 0;
+			bool Pending = false;
+		};
+
+		std::vector<TimerQuery> m_Queries;
+		uint32_t m_Head = 0;
+		uint32_t m_Tail = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "mpch.h"
+#include "Renderer/NullRendererAPI.h"
+
+#include "Renderer/Texture.h"
+
+namespace MoonEngine
+{
+	void NullRendererAPI::SetTarget(const RenderTarget& target)
+	{
+		m_Target = target;
+		Record(RecordedCommand::Type::SetTarget, (uint32_t)target.Framebuffer);
+	}
+
+	void NullRendererAPI::DrawIndexed(uint32_t vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		Record(RecordedCommand::Type::DrawIndexed, vertexArray, indexCount, 1, baseVertex);
+	}
+
+	void NullRendererAPI::DrawIndexedInstanced(uint32_t vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		Record(RecordedCommand::Type::DrawIndexedInstanced, vertexArray, indexCount, instanceCount, baseInstance);
+	}
+
+	void NullRendererAPI::CopyTexture(const Texture& source, uint32_t sourceX, uint32_t sourceY, const Texture& destination, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		Record(RecordedCommand::Type::CopyTexture, 0, width * height);
+	}
+
+	void NullRendererAPI::UploadTexture(const Texture& texture, uint32_t level, uint32_t pixelBuffer, uint32_t offset)
+	{
+		Record(RecordedCommand::Type::UploadTexture, pixelBuffer, std::max(texture.GetWidth() >> level, 1u) * std::max(texture.GetHeight() >> level, 1u) * 4, level, offset);
+	}
+}
\ No newline at end of file
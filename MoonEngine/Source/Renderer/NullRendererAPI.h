@@ -0,0 +1,69 @@
+#pragma once
+#include "Renderer/RendererAPI.h"
+
+namespace MoonEngine
+{
+	struct RecordedCommand
+	{
+		enum class Type
+		{
+			Clear,
+			SetTarget,
+			UpdateBuffer,
+			DrawIndexed,
+			DrawIndexedInstanced,
+			CopyTexture,
+			UploadTexture
+		};
+
+		Type CommandType;
+		//Buffer or vertex array the command works on
+		uint32_t Object = 0;
+		//Indices, vertices or bytes depending on the command
+		uint32_t Count = 0;
+		//Instances, or the mip level of a texture upload
+		uint32_t Instances = 0;
+		//Base vertex or base instance
+		uint32_t Offset = 0;
+	};
+
+	//Backend without a gpu. Objects are plain ids and every command is appended to a list that tests and benchmarks can inspect
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		void Init() override {}
+
+		void SetClearColor(const glm::vec3& color) override {}
+		void Clear() override { Record(RecordedCommand::Type::Clear); }
+		RenderTarget GetTarget() override { return m_Target; }
+		void SetTarget(const RenderTarget& target) override;
+		void SetDepthMode(DepthMode mode) override {}
+		void SetBlendMode(BlendMode mode) override {}
+
+		uint32_t CreateBuffer(uint32_t size, const void* data) override { return ++m_ObjectCount; }
+		void UpdateBuffer(uint32_t buffer, const void* data, uint32_t size) override { Record(RecordedCommand::Type::UpdateBuffer, buffer, size); }
+		void DeleteBuffer(uint32_t buffer) override {}
+		void BindUniformBuffer(uint32_t binding, uint32_t buffer) override {}
+		uint32_t CreateVertexArray(const VertexLayout& layout, uint32_t vertexBuffer, uint32_t indexBuffer) override { return ++m_ObjectCount; }
+		void DeleteVertexArray(uint32_t vertexArray) override {}
+
+		void DrawIndexed(uint32_t vertexArray, uint32_t indexCount, uint32_t baseVertex) override;
+		void DrawIndexedInstanced(uint32_t vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) override;
+
+		void ClearTexture(const Texture& texture) override {}
+		void CopyTexture(const Texture& source, uint32_t sourceX, uint32_t sourceY, const Texture& destination, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		void UploadTexture(const Texture& texture, uint32_t level, uint32_t pixelBuffer, uint32_t offset) override;
+
+		const std::vector<RecordedCommand>& GetCommands() const { return m_Commands; }
+		void ClearCommands() { m_Commands.clear(); }
+	private:
+		std::vector<RecordedCommand> m_Commands;
+		RenderTarget m_Target;
+		uint32_t m_ObjectCount = 0;
+
+		void Record(RecordedCommand::Type type, uint32_t object = 0, uint32_t count = 0, uint32_t instances = 0, uint32_t offset = 0)
+		{
+			m_Commands.push_back({ type, object, count, instances, offset });
+		}
+	};
+}
\ No newline at end of file
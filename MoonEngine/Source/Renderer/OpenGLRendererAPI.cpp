@@ -0,0 +1,196 @@
+#include "mpch.h"
+#include "Renderer/OpenGLRendererAPI.h"
+
+#include "Renderer/Texture.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace MoonEngine
+{
+	typedef void (APIENTRYP MaxShaderCompilerThreadsFunc)(GLuint count);
+
+	static bool HasExtension(const char* name)
+	{
+		int32_t count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (int32_t i = 0; i < count; i++)
+			if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, i), name) == 0)
+				return true;
+
+		return false;
+	}
+
+	void OpenGLRendererAPI::Init()
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		//Lets the driver compile shaders that miss the program cache on its own threads, the loader does not know the extension
+		MaxShaderCompilerThreadsFunc maxShaderCompilerThreads = nullptr;
+		if (HasExtension("GL_KHR_parallel_shader_compile"))
+			maxShaderCompilerThreads = (MaxShaderCompilerThreadsFunc)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+		else if (HasExtension("GL_ARB_parallel_shader_compile"))
+			maxShaderCompilerThreads = (MaxShaderCompilerThreadsFunc)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+
+		if (maxShaderCompilerThreads)
+			maxShaderCompilerThreads(0xffffffff);
+	}
+
+	void OpenGLRendererAPI::SetClearColor(const glm::vec3& color)
+	{
+		glClearColor(color.x, color.y, color.z, 1.0f);
+	}
+
+	void OpenGLRendererAPI::Clear()
+	{
+		//Pooled targets are often larger than the viewport, only the part that is drawn to gets cleared
+		int32_t viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(viewport[0], viewport[1], viewport[2], viewport[3]);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glDisable(GL_SCISSOR_TEST);
+	}
+
+	RenderTarget OpenGLRendererAPI::GetTarget()
+	{
+		RenderTarget target;
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &target.Framebuffer);
+		glGetIntegerv(GL_VIEWPORT, target.Viewport);
+		//Framebuffers bound outside SetTarget, like the gui ones, are assumed to have depth
+		target.Depth = target.Framebuffer != m_Target.Framebuffer || m_Target.Depth;
+		return target;
+	}
+
+	void OpenGLRendererAPI::SetTarget(const RenderTarget& target)
+	{
+		m_Target = target;
+		glBindFramebuffer(GL_FRAMEBUFFER, target.Framebuffer);
+		glViewport(target.Viewport[0], target.Viewport[1], target.Viewport[2], target.Viewport[3]);
+	}
+
+	void OpenGLRendererAPI::SetDepthMode(DepthMode mode)
+	{
+		switch (mode)
+		{
+			case DepthMode::Off:
+				glDisable(GL_DEPTH_TEST);
+				glDepthMask(GL_TRUE);
+				break;
+			case DepthMode::TestWrite:
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(GL_LESS);
+				glDepthMask(GL_TRUE);
+				break;
+			case DepthMode::Test:
+				//Equal depth passes so translucent sprites still cover opaque ones of their own layer
+				glEnable(GL_DEPTH_TEST);
+				glDepthFunc(GL_LEQUAL);
+				glDepthMask(GL_FALSE);
+				break;
+		}
+	}
+
+	void OpenGLRendererAPI::SetBlendMode(BlendMode mode)
+	{
+		if (mode == BlendMode::Additive)
+			glBlendFunc(GL_ONE, GL_ONE);
+		else
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	uint32_t OpenGLRendererAPI::CreateBuffer(uint32_t size, const void* data)
+	{
+		uint32_t buffer = 0;
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, size, data, GL_DYNAMIC_STORAGE_BIT);
+		return buffer;
+	}
+
+	void OpenGLRendererAPI::UpdateBuffer(uint32_t buffer, const void* data, uint32_t size)
+	{
+		glNamedBufferSubData(buffer, 0, size, data);
+	}
+
+	void OpenGLRendererAPI::DeleteBuffer(uint32_t buffer)
+	{
+		glDeleteBuffers(1, &buffer);
+	}
+
+	void OpenGLRendererAPI::BindUniformBuffer(uint32_t binding, uint32_t buffer)
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+	}
+
+	uint32_t OpenGLRendererAPI::CreateVertexArray(const VertexLayout& layout, uint32_t vertexBuffer, uint32_t indexBuffer)
+	{
+		uint32_t vertexArray = 0;
+		glCreateVertexArrays(1, &vertexArray);
+
+		glVertexArrayVertexBuffer(vertexArray, 0, vertexBuffer, 0, layout.Stride);
+		glVertexArrayBindingDivisor(vertexArray, 0, layout.PerInstance ? 1 : 0);
+
+		for (uint32_t i = 0; i < (uint32_t)layout.Attributes.size(); i++)
+		{
+			const VertexAttribute& attribute = layout.Attributes[i];
+			glEnableVertexArrayAttrib(vertexArray, i);
+			glVertexArrayAttribBinding(vertexArray, i, 0);
+
+			switch (attribute.Type)
+			{
+				case AttributeType::Float:
+					glVertexArrayAttribFormat(vertexArray, i, attribute.Components, GL_FLOAT, GL_FALSE, attribute.Offset);
+					break;
+				case AttributeType::Int:
+					glVertexArrayAttribIFormat(vertexArray, i, attribute.Components, GL_INT, attribute.Offset);
+					break;
+				case AttributeType::UByteNormalized:
+					glVertexArrayAttribFormat(vertexArray, i, attribute.Components, GL_UNSIGNED_BYTE, GL_TRUE, attribute.Offset);
+					break;
+			}
+		}
+
+		if (indexBuffer)
+			glVertexArrayElementBuffer(vertexArray, indexBuffer);
+
+		return vertexArray;
+	}
+
+	void OpenGLRendererAPI::DeleteVertexArray(uint32_t vertexArray)
+	{
+		glDeleteVertexArrays(1, &vertexArray);
+	}
+
+	void OpenGLRendererAPI::DrawIndexed(uint32_t vertexArray, uint32_t indexCount, uint32_t baseVertex)
+	{
+		glBindVertexArray(vertexArray);
+		glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, 0, baseVertex);
+	}
+
+	void OpenGLRendererAPI::DrawIndexedInstanced(uint32_t vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance)
+	{
+		glBindVertexArray(vertexArray);
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, 0, (GLsizei)instanceCount, baseInstance);
+	}
+
+	void OpenGLRendererAPI::ClearTexture(const Texture& texture)
+	{
+		uint32_t clearColor = 0;
+		glClearTexImage(texture.GetTextureId(), 0, GL_RGBA, GL_UNSIGNED_BYTE, &clearColor);
+	}
+
+	void OpenGLRendererAPI::CopyTexture(const Texture& source, uint32_t sourceX, uint32_t sourceY, const Texture& destination, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		glCopyImageSubData(source.GetTextureId(), GL_TEXTURE_2D, 0, sourceX, sourceY, 0, destination.GetTextureId(), GL_TEXTURE_2D, 0, x, y, 0, width, height, 1);
+	}
+
+	void OpenGLRendererAPI::UploadTexture(const Texture& texture, uint32_t level, uint32_t pixelBuffer, uint32_t offset)
+	{
+		//With an unpack buffer bound the data pointer is an offset into it and the copy runs on the gpu timeline
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+		glTextureSubImage2D(texture.GetTextureId(), level, 0, 0, std::max(texture.GetWidth() >> level, 1u), std::max(texture.GetHeight() >> level, 1u), GL_RGBA, GL_UNSIGNED_BYTE, (const void*)(uintptr_t)offset);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+}
\ No newline at end of file
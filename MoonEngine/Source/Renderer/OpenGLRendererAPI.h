@@ -0,0 +1,35 @@
+#pragma once
+#include "Renderer/RendererAPI.h"
+
+namespace MoonEngine
+{
+	class OpenGLRendererAPI : public RendererAPI
+	{
+	public:
+		void Init() override;
+
+		void SetClearColor(const glm::vec3& color) override;
+		void Clear() override;
+		RenderTarget GetTarget() override;
+		void SetTarget(const RenderTarget& target) override;
+		void SetDepthMode(DepthMode mode) override;
+		void SetBlendMode(BlendMode mode) override;
+
+		uint32_t CreateBuffer(uint32_t size, const void* data) override;
+		void UpdateBuffer(uint32_t buffer, const void* data, uint32_t size) override;
+		void DeleteBuffer(uint32_t buffer) override;
+		void BindUniformBuffer(uint32_t binding, uint32_t buffer) override;
+		uint32_t CreateVertexArray(const VertexLayout& layout, uint32_t vertexBuffer, uint32_t indexBuffer) override;
+		void DeleteVertexArray(uint32_t vertexArray) override;
+
+		void DrawIndexed(uint32_t vertexArray, uint32_t indexCount, uint32_t baseVertex) override;
+		void DrawIndexedInstanced(uint32_t vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) override;
+
+		void ClearTexture(const Texture& texture) override;
+		void CopyTexture(const Texture& source, uint32_t sourceX, uint32_t sourceY, const Texture& destination, uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		void UploadTexture(const Texture& texture, uint32_t level, uint32_t pixelBuffer, uint32_t offset) override;
+	private:
+		//Gl can not tell what is attached without a query per call, so the last target set is remembered
+		RenderTarget m_Target;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "mpch.h"
+#include "Renderer/RenderGraph.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/RendererAPI.h"
+#include "Renderer/RenderTargetPool.h"
+
+#include <glad/glad.h>
+#include <queue>
+
+namespace MoonEngine
+{
+	void RenderGraph::PassBuilder::Write(RenderGraphTexture texture)
+	{
+		m_Graph.m_Passes[m_Pass].Writes.push_back(texture);
+		m_Graph.m_Textures[texture].Writers.push_back(m_Pass);
+	}
+
+	void RenderGraph::PassBuilder::Read(RenderGraphTexture texture)
+	{
+		m_Graph.m_Passes[m_Pass].Reads.push_back(texture);
+		m_Graph.m_Textures[texture].Readers++;
+	}
+
+	void RenderGraph::PassBuilder::SideEffect()
+	{
+		m_Graph.m_Passes[m_Pass].SideEffect = true;
+	}
+
+	RenderGraphTexture RenderGraph::Import(const char* name, uint32_t texture, FramebufferTextureFormat format, uint32_t width, uint32_t height)
+	{
+		GraphTexture& graphTexture = m_Textures.emplace_back();
+		graphTexture.Name = name;
+		graphTexture.Format = format;
+		graphTexture.Width = width;
+		graphTexture.Height = height;
+		graphTexture.Id = texture;
+		graphTexture.Imported = true;
+		return (RenderGraphTexture)m_Textures.size() - 1;
+	}
+
+	RenderGraphTexture RenderGraph::Create(const char* name, FramebufferTextureFormat format, uint32_t width, uint32_t height)
+	{
+		GraphTexture& graphTexture = m_Textures.emplace_back();
+		graphTexture.Name = name;
+		graphTexture.Format = format;
+		graphTexture.Width = std::max(width, 1u);
+		graphTexture.Height = std::max(height, 1u);
+		return (RenderGraphTexture)m_Textures.size() - 1;
+	}
+
+	void RenderGraph::AddPass(const char* name, const std::function<void(PassBuilder&)>& setup, const std::function<void()>& execute)
+	{
+		uint32_t index = (uint32_t)m_Passes.size();
+		GraphPass& pass = m_Passes.emplace_back();
+		pass.Name = name;
+		pass.Execute = execute;
+
+		PassBuilder builder(*this, index);
+		setup(builder);
+
+		ME_ASSERT((!m_Passes[index].Writes.empty()), "Render graph pass has no target to draw into!");
+	}
+
+	void RenderGraph::Cull()
+	{
+		//Walks back from textures nobody reads, a pass goes once everything it writes is unused
+		std::vector<RenderGraphTexture> unused;
+		for (GraphPass& pass : m_Passes)
+			pass.References = (uint32_t)pass.Writes.size();
+
+		for (RenderGraphTexture texture = 0; texture < (RenderGraphTexture)m_Textures.size(); texture++)
+			if (!m_Textures[texture].Imported && m_Textures[texture].Readers == 0)
+				unused.push_back(texture);
+
+		while (!unused.empty())
+		{
+			GraphTexture& texture = m_Textures[unused.back()];
+			unused.pop_back();
+
+			for (uint32_t writer : texture.Writers)
+			{
+				GraphPass& pass = m_Passes[writer];
+				if (pass.References == 0 || --pass.References > 0 || pass.SideEffect)
+					continue;
+
+				for (RenderGraphTexture read : pass.Reads)
+					if (--m_Textures[read].Readers == 0 && !m_Textures[read].Imported)
+						unused.push_back(read);
+			}
+		}
+	}
+
+	std::vector<uint32_t> RenderGraph::SortPasses() const
+	{
+		//A pass waits for every pass writing what it reads, writers of one texture wait for each other in the order they were added
+		uint32_t passCount = (uint32_t)m_Passes.size();
+		std::vector<std::vector<uint32_t>> dependents(passCount);
+		std::vector<uint32_t> dependencies(passCount, 0);
+
+		auto depend = [&](uint32_t before, uint32_t after)
+		{
+			if (before == after)
+				return;
+
+			dependents[before].push_back(after);
+			dependencies[after]++;
+		};
+
+		uint32_t liveCount = 0;
+		for (uint32_t index = 0; index < passCount; index++)
+		{
+			if (!IsLive(index))
+				continue;
+
+			liveCount++;
+			for (RenderGraphTexture read : m_Passes[index].Reads)
+				for (uint32_t writer : m_Textures[read].Writers)
+					if (IsLive(writer))
+						depend(writer, index);
+		}
+
+		for (const GraphTexture& texture : m_Textures)
+		{
+			uint32_t previous = UINT32_MAX;
+			for (uint32_t writer : texture.Writers)
+			{
+				if (!IsLive(writer))
+					continue;
+
+				if (previous != UINT32_MAX)
+					depend(previous, writer);
+				previous = writer;
+			}
+		}
+
+		//Lowest ready index first, so passes with nothing between them run in the order they were added
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+		for (uint32_t index = 0; index < passCount; index++)
+			if (IsLive(index) && dependencies[index] == 0)
+				ready.push(index);
+
+		std::vector<uint32_t> order;
+		order.reserve(liveCount);
+		while (!ready.empty())
+		{
+			uint32_t index = ready.top();
+			ready.pop();
+			order.push_back(index);
+
+			for (uint32_t dependent : dependents[index])
+				if (--dependencies[dependent] == 0)
+					ready.push(dependent);
+		}
+
+		ME_ASSERT((order.size() == liveCount), "Render graph passes read each other's results in a cycle!");
+
+		//Past the assert the passes left in the cycle still run, in the order they were added
+		for (uint32_t index = 0; index < passCount && order.size() < liveCount; index++)
+			if (IsLive(index) && dependencies[index] > 0)
+				order.push_back(index);
+
+		return order;
+	}
+
+	void RenderGraph::BindPass(uint32_t index)
+	{
+		const GraphPass& pass = m_Passes[index];
+		const GraphTexture& first = m_Textures[pass.Writes.front()];
+
+		if (m_Framebuffers.size() <= index)
+			m_Framebuffers.resize(index + 1);
+
+		PassFramebuffer& framebuffer = m_Framebuffers[index];
+		if (!RendererAPI::IsNull())
+		{
+			std::vector<uint32_t> attachments;
+			for (RenderGraphTexture write : pass.Writes)
+				attachments.push_back(m_Textures[write].Id);
+
+			if (!framebuffer.Id)
+				glCreateFramebuffers(1, &framebuffer.Id);
+
+			if (attachments != framebuffer.Attachments)
+			{
+				uint32_t colorCount = 0;
+				bool hasDepth = false;
+				for (RenderGraphTexture write : pass.Writes)
+				{
+					const GraphTexture& texture = m_Textures[write];
+					if (texture.Format == FramebufferTextureFormat::DEPTH)
+					{
+						glNamedFramebufferTexture(framebuffer.Id, GL_DEPTH_STENCIL_ATTACHMENT, texture.Id, 0);
+						hasDepth = true;
+					}
+					else
+						glNamedFramebufferTexture(framebuffer.Id, GL_COLOR_ATTACHMENT0 + colorCount++, texture.Id, 0);
+				}
+
+				//Attachments left over from the last frame would still be drawn into
+				for (uint32_t i = colorCount; i < (uint32_t)framebuffer.Attachments.size(); i++)
+					glNamedFramebufferTexture(framebuffer.Id, GL_COLOR_ATTACHMENT0 + i, 0, 0);
+				if (!hasDepth)
+					glNamedFramebufferTexture(framebuffer.Id, GL_DEPTH_STENCIL_ATTACHMENT, 0, 0);
+
+				GLenum buffers[4] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3 };
+				glNamedFramebufferDrawBuffers(framebuffer.Id, std::min(colorCount, 4u), buffers);
+
+				framebuffer.Attachments = std::move(attachments);
+			}
+		}
+
+		bool depth = std::any_of(pass.Writes.begin(), pass.Writes.end(), [&](RenderGraphTexture write) { return m_Textures[write].Format == FramebufferTextureFormat::DEPTH; });
+		RendererAPI::Get()->SetTarget({ (int32_t)framebuffer.Id, { 0, 0, (int32_t)first.Width, (int32_t)first.Height }, depth });
+	}
+
+	void RenderGraph::Execute()
+	{
+		Cull();
+		std::vector<uint32_t> order = SortPasses();
+
+		//Lifetimes only span the passes that survived culling
+		for (uint32_t position = 0; position < (uint32_t)order.size(); position++)
+		{
+			const GraphPass& pass = m_Passes[order[position]];
+
+			auto extend = [position](GraphTexture& texture)
+			{
+				texture.FirstPass = std::min(texture.FirstPass, position);
+				texture.LastPass = std::max(texture.LastPass, position);
+			};
+
+			for (RenderGraphTexture write : pass.Writes)
+				extend(m_Textures[write]);
+			for (RenderGraphTexture read : pass.Reads)
+				extend(m_Textures[read]);
+		}
+
+		RendererAPI* api = RendererAPI::Get();
+		RenderTarget target = api->GetTarget();
+
+		for (uint32_t position = 0; position < (uint32_t)order.size(); position++)
+		{
+			uint32_t index = order[position];
+			GraphPass& pass = m_Passes[index];
+
+			for (GraphTexture& texture : m_Textures)
+			{
+				if (!texture.Imported && texture.FirstPass == position)
+				{
+					uint32_t width = texture.Width;
+					uint32_t height = texture.Height;
+					texture.Id = RenderTargetPool::Acquire(texture.Format, width, height);
+				}
+			}
+
+			BindPass(index);
+			pass.Execute();
+
+			//Draws into a texture have to be issued before another pass or view is handed the same texture
+			bool flushed = false;
+			for (GraphTexture& texture : m_Textures)
+			{
+				if (texture.Imported || texture.LastPass != position || texture.FirstPass == UINT32_MAX)
+					continue;
+
+				if (!flushed)
+				{
+					Renderer::Flush();
+					flushed = true;
+				}
+
+				RenderTargetPool::Release(texture.Id);
+				texture.Id = 0;
+			}
+		}
+
+		api->SetTarget(target);
+
+		m_LastPassCount = (uint32_t)m_Passes.size();
+		m_LastCulledCount = (uint32_t)(m_Passes.size() - order.size());
+		m_Passes.clear();
+		m_Textures.clear();
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		//Views can outlive the renderer
+		if (!RendererAPI::Get() || RendererAPI::IsNull())
+			return;
+
+		for (PassFramebuffer& framebuffer : m_Framebuffers)
+			if (framebuffer.Id)
+				glDeleteFramebuffers(1, &framebuffer.Id);
+	}
+}
\ No newline at end of file
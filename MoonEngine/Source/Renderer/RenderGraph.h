@@ -0,0 +1,103 @@
+#pragma once
+#include "Renderer/Framebuffer.h"
+
+namespace MoonEngine
+{
+	//Handle of a texture declared in a RenderGraph, valid until the graph is executed
+	using RenderGraphTexture = uint32_t;
+
+	//Passes of one view declared for a single frame. Execute drops passes whose results nobody uses and runs the rest after
+	//the passes writing what they read, passes writing the same texture and independent ones keep the order they were added in.
+	//Transient textures come from the RenderTargetPool at their first use and go back after their last, so passes and views that
+	//run one after another share the same textures
+	class RenderGraph
+	{
+	public:
+		class PassBuilder
+		{
+		public:
+			//Drawn into by the pass, colour textures are attached in the order they are written
+			void Write(RenderGraphTexture texture);
+			//Sampled by the pass, keeps the passes writing it alive
+			void Read(RenderGraphTexture texture);
+			//Keeps the pass even when nothing it writes is used
+			void SideEffect();
+		private:
+			PassBuilder(RenderGraph& graph, uint32_t pass)
+				:m_Graph(graph), m_Pass(pass) {}
+
+			RenderGraph& m_Graph;
+			uint32_t m_Pass;
+
+			friend class RenderGraph;
+		};
+
+		RenderGraph() = default;
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+		~RenderGraph();
+
+		//Texture owned outside the graph, passes writing it are never culled
+		RenderGraphTexture Import(const char* name, uint32_t texture, FramebufferTextureFormat format, uint32_t width, uint32_t height);
+		//Texture that only lives while the passes using it run, its contents are undefined until a pass clears it
+		RenderGraphTexture Create(const char* name, FramebufferTextureFormat format, uint32_t width, uint32_t height);
+
+		//Setup runs right away, execute runs from Execute with the pass attachments bound as the render target
+		void AddPass(const char* name, const std::function<void(PassBuilder&)>& setup, const std::function<void()>& execute);
+
+		//Gl texture behind a handle, only valid inside the execute callbacks of passes that declared it
+		uint32_t GetTexture(RenderGraphTexture texture) const { return m_Textures[texture].Id; }
+
+		//Runs the frame and clears the declarations, the framebuffers of the passes are kept for the next frame
+		void Execute();
+
+		uint32_t GetPassCount() const { return m_LastPassCount; }
+		uint32_t GetCulledPassCount() const { return m_LastCulledCount; }
+	private:
+		struct GraphTexture
+		{
+			std::string Name;
+			FramebufferTextureFormat Format;
+			uint32_t Width;
+			uint32_t Height;
+			uint32_t Id = 0;
+			bool Imported = false;
+
+			uint32_t Readers = 0;
+			std::vector<uint32_t> Writers;
+			//Positions in the execution order, not pass indices
+			uint32_t FirstPass = UINT32_MAX;
+			uint32_t LastPass = 0;
+		};
+
+		struct GraphPass
+		{
+			std::string Name;
+			std::vector<RenderGraphTexture> Writes;
+			std::vector<RenderGraphTexture> Reads;
+			std::function<void()> Execute;
+			bool SideEffect = false;
+			uint32_t References = 0;
+		};
+
+		//Framebuffer of a pass slot and the textures attached to it last time, reattached only when they change
+		struct PassFramebuffer
+		{
+			uint32_t Id = 0;
+			std::vector<uint32_t> Attachments;
+		};
+
+		std::vector<GraphTexture> m_Textures;
+		std::vector<GraphPass> m_Passes;
+		std::vector<PassFramebuffer> m_Framebuffers;
+
+		uint32_t m_LastPassCount = 0;
+		uint32_t m_LastCulledCount = 0;
+
+		bool IsLive(uint32_t pass) const { return m_Passes[pass].References > 0 || m_Passes[pass].SideEffect; }
+
+		void Cull();
+		std::vector<uint32_t> SortPasses() const;
+		void BindPass(uint32_t pass);
+	};
+}
\ No newline at end of file
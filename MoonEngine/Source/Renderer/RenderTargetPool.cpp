@@ -0,0 +1,168 @@
+#include "mpch.h"
+#include "Renderer/RenderTargetPool.h"
+
+#include "Renderer/Renderer.h"
+#include "Renderer/RendererAPI.h"
+
+#include <glad/glad.h>
+
+namespace MoonEngine
+{
+	//Sizes are multiples of the bucket, growing adds headroom so dragging a dock wider does not hit every bucket on the way
+	const uint32_t BucketSize = 256;
+	const float GrowHeadroom = 1.25f;
+	//Free textures nobody asked for in this many frames are deleted
+	const uint64_t IdleFrames = 300;
+
+	struct PooledTexture
+	{
+		uint32_t Id = 0;
+		FramebufferTextureFormat Format = FramebufferTextureFormat::None;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		bool InUse = false;
+		uint64_t LastUsed = 0;
+	};
+
+	struct PoolData
+	{
+		std::vector<PooledTexture> Textures;
+		uint64_t Frame = 0;
+		uint32_t Allocations = 0;
+		uint32_t Reallocations = 0;
+		bool Terminated = false;
+	};
+
+	static PoolData s_Pool;
+
+	static uint32_t RoundToBucket(float size)
+	{
+		uint32_t rounded = (uint32_t)std::ceil(size);
+		return std::max((rounded + BucketSize - 1) / BucketSize, 1u) * BucketSize;
+	}
+
+	static uint32_t CreateTexture(FramebufferTextureFormat format, uint32_t width, uint32_t height)
+	{
+		uint32_t texture = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+
+		switch (format)
+		{
+			case FramebufferTextureFormat::RGBA8:
+				glTextureStorage2D(texture, 1, GL_RGBA8, width, height);
+				glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				break;
+			case FramebufferTextureFormat::RED_INTEGER:
+				glTextureStorage2D(texture, 1, GL_R32I, width, height);
+				glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				break;
+			case FramebufferTextureFormat::DEPTH:
+				glTextureStorage2D(texture, 1, GL_DEPTH24_STENCIL8, width, height);
+				break;
+		}
+
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		return texture;
+	}
+
+	uint32_t RenderTargetPool::Acquire(FramebufferTextureFormat format, uint32_t& width, uint32_t& height, uint32_t previous)
+	{
+		if (RendererAPI::IsNull())
+			return 0;
+
+		if (previous)
+		{
+			Release(previous);
+			s_Pool.Reallocations++;
+		}
+
+		//Smallest free texture that fits, anything bigger would only be wasted on this target
+		PooledTexture* best = nullptr;
+		for (PooledTexture& pooled : s_Pool.Textures)
+		{
+			if (pooled.InUse || pooled.Format != format || pooled.Width < width || pooled.Height < height)
+				continue;
+
+			if (!best || pooled.Width * pooled.Height < best->Width * best->Height)
+				best = &pooled;
+		}
+
+		if (!best)
+		{
+			float headroom = previous ? GrowHeadroom : 1.0f;
+
+			PooledTexture pooled;
+			pooled.Format = format;
+			pooled.Width = RoundToBucket(width * headroom);
+			pooled.Height = RoundToBucket(height * headroom);
+			pooled.Id = CreateTexture(format, pooled.Width, pooled.Height);
+
+			s_Pool.Textures.push_back(pooled);
+			s_Pool.Allocations++;
+			best = &s_Pool.Textures.back();
+		}
+
+		best->InUse = true;
+		best->LastUsed = s_Pool.Frame;
+		width = best->Width;
+		height = best->Height;
+		return best->Id;
+	}
+
+	void RenderTargetPool::Release(uint32_t texture)
+	{
+		if (!texture || RendererAPI::IsNull())
+			return;
+
+		//Framebuffers can outlive the renderer, by then nothing is left to hand the texture to
+		if (s_Pool.Terminated)
+		{
+			glDeleteTextures(1, &texture);
+			return;
+		}
+
+		for (PooledTexture& pooled : s_Pool.Textures)
+		{
+			if (pooled.Id == texture)
+			{
+				pooled.InUse = false;
+				pooled.LastUsed = s_Pool.Frame;
+				return;
+			}
+		}
+	}
+
+	void RenderTargetPool::Update(RendererStats& stats)
+	{
+		s_Pool.Frame = stats.Frame;
+
+		auto idle = [](const PooledTexture& pooled)
+		{
+			return !pooled.InUse && s_Pool.Frame - pooled.LastUsed > IdleFrames;
+		};
+
+		for (PooledTexture& pooled : s_Pool.Textures)
+			if (idle(pooled))
+				glDeleteTextures(1, &pooled.Id);
+
+		s_Pool.Textures.erase(std::remove_if(s_Pool.Textures.begin(), s_Pool.Textures.end(), idle), s_Pool.Textures.end());
+
+		stats.RenderTargets = (uint32_t)s_Pool.Textures.size();
+		stats.RenderTargetAllocations = s_Pool.Allocations;
+		stats.RenderTargetReallocations = s_Pool.Reallocations;
+	}
+
+	void RenderTargetPool::Terminate()
+	{
+		//Textures still attached are deleted by their framebuffer
+		for (PooledTexture& pooled : s_Pool.Textures)
+			if (!pooled.InUse && !RendererAPI::IsNull())
+				glDeleteTextures(1, &pooled.Id);
+
+		s_Pool.Textures.clear();
+		s_Pool.Terminated = true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include "Renderer/Framebuffer.h"
+
+namespace MoonEngine
+{
+	struct RendererStats;
+
+	//Attachment textures shared by every framebuffer. Sizes are rounded up to buckets and never shrink, so a view resized
+	//inside its bucket keeps its textures and one that outgrows them leaves them to the next view that fits
+	class RenderTargetPool
+	{
+	public:
+		//Texture of at least width x height, the size it really has is written back
+		//previous is handed back first so a growing attachment can reuse a bigger free texture
+		static uint32_t Acquire(FramebufferTextureFormat format, uint32_t& width, uint32_t& height, uint32_t previous = 0);
+		static void Release(uint32_t texture);
+	private:
+		static void Terminate();
+		//Deletes textures nobody acquired for a while and reports the counters
+		static void Update(RendererStats& stats);
+
+		friend class Renderer;
+	};
+}
\ No newline at end of file
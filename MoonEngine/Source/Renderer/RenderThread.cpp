@@ -0,0 +1,61 @@
+#include "mpch.h"
+#include "Renderer/RenderThread.h"
+
+namespace MoonEngine
+{
+	RenderThread::RenderThread()
+	{
+		m_Thread = std::thread(&RenderThread::Loop, this);
+	}
+
+	void RenderThread::Submit(const std::function<void()>& job)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_JobDone.wait(lock, [this] { return !m_Busy; });
+
+		m_Job = job;
+		m_Busy = true;
+		m_JobReady.notify_one();
+	}
+
+	void RenderThread::Wait()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_JobDone.wait(lock, [this] { return !m_Busy; });
+	}
+
+	void RenderThread::Loop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_JobReady.wait(lock, [this] { return m_Busy || !m_Running; });
+
+				if (!m_Busy)
+					return;
+
+				job = std::move(m_Job);
+			}
+
+			job();
+
+			{
+				std::scoped_lock<std::mutex> lock(m_Mutex);
+				m_Busy = false;
+			}
+			m_JobDone.notify_all();
+		}
+	}
+
+	RenderThread::~RenderThread()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			m_Running = false;
+		}
+		m_JobReady.notify_one();
+		m_Thread.join();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace MoonEngine
+{
+	//Dedicated worker that runs one renderer job at a time next to the main thread. Jobs must not touch the gl context
+	class RenderThread
+	{
+	public:
+		RenderThread();
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+		~RenderThread();
+
+		//Waits for the running job before handing over the next one
+		void Submit(const std::function<void()>& job);
+		void Wait();
+	private:
+		std::thread m_Thread;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobReady;
+		std::condition_variable m_JobDone;
+
+		std::function<void()> m_Job;
+		bool m_Busy = false;
+		bool m_Running = true;
+
+		void Loop();
+	};
+}
\ No newline at end of file
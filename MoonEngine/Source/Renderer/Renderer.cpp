@@ -1,13 +1,29 @@
 #include "mpch.h"
 #include "Renderer/Renderer.h"
 
+#include "Core/Time.h"
+
 #include "Engine/Components.h"
 
+#include "Renderer/DebugRenderer.h"
+#include "Renderer/FrameCapture.h"
+#include "Renderer/GpuTimer.h"
+#include "Renderer/RendererAPI.h"
+#include "Renderer/RenderTargetPool.h"
+#include "Renderer/RenderThread.h"
 #include "Renderer/Shader.h"
+#include "Renderer/StaticBatch.h"
+#include "Renderer/StreamBuffer.h"
 #include "Renderer/Texture.h"
+#include "Renderer/TextureAtlas.h"
+#include "Renderer/TextureLoader.h"
 #include "Renderer/TextureSheet.h"
+#include "Renderer/Tilemap.h"
+#include "Renderer/WorkerPool.h"
+
+#include "Utils/Maths.h"
 
-#include <glad/glad.h>
+#include <chrono>
 
 namespace MoonEngine
 {
@@ -34,98 +50,694 @@ namespace MoonEngine
 		glm::vec2 TextureCoord;
 		int32_t TextureId;
 		glm::vec2 Tiling;
-		int EntityId;
+		float Depth;
 	};
 
-	struct LineVertex
+	//One record per sprite for the instanced path, corners are expanded in the vertex shader
+	struct QuadInstance
 	{
+		glm::vec4 Axes;
+		glm::vec3 Position;
+		uint32_t Color;
+		glm::vec4 TexRect;
+		glm::vec2 Tiling;
+		int32_t TextureId;
+		float Depth;
+	};
+
+	const VertexLayout QuadVertexLayout =
+	{
+		sizeof(QuadVertex), false,
+		{
+			{ AttributeType::Float, 3, offsetof(QuadVertex, Position) },
+			{ AttributeType::Float, 4, offsetof(QuadVertex, Color) },
+			{ AttributeType::Float, 2, offsetof(QuadVertex, TextureCoord) },
+			{ AttributeType::Int, 1, offsetof(QuadVertex, TextureId) },
+			{ AttributeType::Float, 2, offsetof(QuadVertex, Tiling) },
+			{ AttributeType::Float, 1, offsetof(QuadVertex, Depth) }
+		}
+	};
+
+	//Shared by the quad stream and the static chunks
+	const VertexLayout QuadInstanceLayout =
+	{
+		sizeof(QuadInstance), true,
+		{
+			{ AttributeType::Float, 4, offsetof(QuadInstance, Axes) },
+			{ AttributeType::Float, 3, offsetof(QuadInstance, Position) },
+			{ AttributeType::UByteNormalized, 4, offsetof(QuadInstance, Color) },
+			{ AttributeType::Float, 4, offsetof(QuadInstance, TexRect) },
+			{ AttributeType::Float, 2, offsetof(QuadInstance, Tiling) },
+			{ AttributeType::Int, 1, offsetof(QuadInstance, TextureId) },
+			{ AttributeType::Float, 1, offsetof(QuadInstance, Depth) }
+		}
+	};
+
+	//Compact record of a submitted quad, vertices are only generated once the queue is sorted
+	struct QuadCommand
+	{
+		glm::vec3 AxisX;
+		glm::vec3 AxisY;
 		glm::vec3 Position;
 		glm::vec4 Color;
-		int EntityId;
+		glm::vec4 TexRect;
+		glm::vec2 Tiling;
+		uint32_t TextureKey;
 	};
 
-	struct QuadLayerArray
+	//Where a texture is sampled from this frame, atlased textures point at their page
+	struct TextureEntry
 	{
-		QuadVertex* QuadVertices = nullptr;
-		uint32_t QuadVertexIndex = 0;
+		uint32_t Key = 0;
+		glm::vec4 Region = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+		glm::vec4 Remap(const glm::vec4& texRect) const
+		{
+			return { Region.x + texRect.x * Region.z, Region.y + texRect.y * Region.w, Region.x + texRect.z * Region.z, Region.y + texRect.w * Region.w };
+		}
 	};
 
-	struct RenderData
+	//Std140 layout of the Frame uniform block, shared by every renderer shader and bound once at binding 0
+	struct FrameUniforms
+	{
+		glm::mat4 ViewProjection;
+		glm::vec2 ViewportSize;
+		float Time;
+		float Padding;
+	};
+
+	const uint32_t FrameUniformBinding = 0;
+
+	//Sort key layout: | layer 16 bits | texture key 16 bits | submission order 32 bits |
+	//The order bits are also the index of the quad in the command arena
+	//Opaque quads are queued with inverted keys, sorting those ascending gives front to back order
+	//and, once equal layer and texture runs are reversed, the quad submitted last first
+	namespace SortKey
+	{
+		constexpr uint32_t LayerShift = 48;
+		constexpr uint32_t TextureShift = 32;
+
+		inline uint64_t Make(uint32_t layer, uint32_t textureKey, uint32_t order)
+		{
+			return ((uint64_t)layer << LayerShift) | ((uint64_t)textureKey << TextureShift) | order;
+		}
+
+		inline uint32_t Layer(uint64_t key) { return (uint32_t)(key >> LayerShift); }
+		inline uint32_t Texture(uint64_t key) { return (uint32_t)(key >> TextureShift) & 0xffff; }
+		inline uint32_t Order(uint64_t key) { return (uint32_t)key; }
+	}
+
+	const uint32_t MaxLayers = 1 << 16;
+	const uint32_t MaxFrameTextures = 1 << 16;
+	const uint32_t MaxTextureSlots = 32;
+	const uint32_t MaxQuads = 5000;
+	const uint32_t MaxVertices = MaxQuads * 4;
+	const uint32_t MaxIndices = MaxQuads * 6;
+	const uint32_t StreamRegions = 3;
+	//Quads written by one worker job, big enough to keep the hand off cheap next to the writing
+	const uint32_t WriteRangeQuads = 2048;
+
+	//Bytes a streamed quad takes in the given render mode
+	static uint32_t GetQuadStride(RenderMode mode)
+	{
+		return mode == RenderMode::Instanced ? sizeof(QuadInstance) : sizeof(QuadVertex) * 4;
+	}
+
+	//Higher layers get smaller depth, the shaders write it in place of the camera depth
+	inline float LayerDepth(uint32_t layer) { return 1.0f - 2.0f * (layer + 1) / (float)(MaxLayers + 1); }
+
+	//The opaque pass keeps only solid texels, blended edges would let the clear colour through the depth they write
+	const float OpaqueAlphaCutoff = 0.5f;
+	constexpr uint32_t AlphaCutoffUniform = Shader::Hash("uAlphaCutoff");
+	constexpr uint32_t OverdrawUniform = Shader::Hash("uOverdraw");
+
+	//Sprites covering everything behind them go to the depth tested pass
+	static bool IsOpaque(const Shared<Texture>& texture, const glm::vec4& color)
+	{
+		return color.a >= 1.0f && (!texture || texture->GetAlphaMode() != AlphaMode::Translucent);
+	}
+
+	//Slice of the quad stream reserved for a packet, a packet bigger than a stream region is split over several
+	struct StreamChunk
+	{
+		uint32_t First;
+		uint32_t Count;
+		uint8_t* Memory;
+		uint32_t Offset;
+	};
+
+	struct QuadBatch
 	{
-		const static uint32_t MaxLayers = 25;
-		const static uint32_t MaxQuads = 750;
-		const static uint32_t MaxVertices = MaxQuads * 4;
-		const static uint32_t MaxIndices = MaxQuads * 6;
+		bool Opaque;
+		uint32_t Layer;
+		uint32_t First;
+		uint32_t Count;
+		uint32_t DrawOffset;
+		uint32_t TextureStart;
+		uint32_t TextureCount;
+		//Stream memory of the first quad
+		uint8_t* Memory;
+	};
+
+	//Slice of a batch handed to one worker, no two ranges share stream memory
+	struct WriteRange
+	{
+		uint32_t Batch;
+		uint32_t First;
+		uint32_t Count;
+	};
+
+	//Retained chunk of a StaticBatch, drawn under the streamed quads of the same layer
+	struct StaticDraw
+	{
+		bool Opaque;
+		uint32_t Layer;
+		uint32_t VertexArray;
+		uint32_t InstanceCount;
+		Shared<Texture> Texture;
+	};
+
+	//Everything recorded between Begin and End. The front end fills it, Prepare runs on the render thread
+	//and only touches the packet, the draw calls are issued later on the gl thread
+	struct FramePacket
+	{
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		RenderMode Mode = RenderMode::Instanced;
+		RenderTarget Target;
+		uint32_t Pass = 0;
+		bool Overdraw = false;
+
+		std::vector<QuadCommand> Quads;
+		std::vector<uint64_t> SortKeys;
+		std::vector<uint64_t> OpaqueKeys;
+		std::vector<StaticDraw> StaticDraws;
+
+		//Textures referenced by the queued quads, key 0 is reserved for the white texture
+		std::vector<Shared<Texture>> Textures;
+		std::unordered_map<Shared<Texture>, uint32_t> TextureKeys;
+		std::unordered_map<Shared<Texture>, TextureEntry> TextureCache;
+
+		//Filled by Prepare
+		std::vector<uint64_t> SortScratch;
+		std::vector<uint32_t> TextureSlots;
+		std::vector<uint32_t> TextureBatches;
+		uint32_t BatchIndex = 0;
+		//Opaque keys lead SortKeys and opaque chunks lead StaticDraws once the packet is prepared
+		uint32_t OpaqueCount = 0;
+		uint32_t OpaqueStaticCount = 0;
+		//Batches cut short by running out of texture slots, folded into the frame stats when the packet is drawn
+		uint32_t TextureSlotFlushes = 0;
+		//Milliseconds spent writing the stream, same as above
+		float WriteTime = 0.0f;
+
+		std::vector<StreamChunk> QuadChunks;
+		std::vector<QuadBatch> Batches;
+		std::vector<uint32_t> BatchTextures;
+		std::vector<WriteRange> WriteRanges;
+
+		bool IsEmpty() const { return Quads.empty() && StaticDraws.empty(); }
+
+		uint32_t GetTextureKey(const Shared<Texture>& texture)
+		{
+			auto it = TextureKeys.find(texture);
+			if (it != TextureKeys.end())
+				return it->second;
+
+			uint32_t textureKey = (uint32_t)Textures.size();
+			ME_ASSERT((textureKey < MaxFrameTextures), "Too many textures in a single frame!");
+			Textures.push_back(texture);
+			TextureKeys[texture] = textureKey;
+			return textureKey;
+		}
+
+		QuadCommand& SubmitQuad(int layer, uint32_t textureKey, bool opaque)
+		{
+			uint32_t order = (uint32_t)Quads.size();
+			uint32_t layerKey = (uint32_t)std::clamp(layer, 0, (int)MaxLayers - 1);
+
+			uint64_t key = SortKey::Make(layerKey, textureKey, order);
+			if (opaque)
+				OpaqueKeys.push_back(~key);
+			else
+				SortKeys.push_back(key);
+
+			QuadCommand& quad = Quads.emplace_back();
+			quad.TextureKey = textureKey;
+			return quad;
+		}
+
+		void Prepare(WorkerPool& workers)
+		{
+			if (!Target.Depth)
+				DropDepthOrder();
+
+			//Opaque chunks run front to back, the rest back to front
+			auto translucent = std::stable_partition(StaticDraws.begin(), StaticDraws.end(), [](const StaticDraw& draw) { return draw.Opaque; });
+			std::reverse(StaticDraws.begin(), translucent);
+			std::stable_sort(StaticDraws.begin(), translucent, [](const StaticDraw& a, const StaticDraw& b) { return a.Layer > b.Layer; });
+			std::stable_sort(translucent, StaticDraws.end(), [](const StaticDraw& a, const StaticDraw& b) { return a.Layer < b.Layer; });
+			OpaqueStaticCount = (uint32_t)(translucent - StaticDraws.begin());
+
+			if (!Quads.empty())
+			{
+				SortQuads(OpaqueKeys);
+				ReverseOpaqueRuns();
+				SortQuads(SortKeys);
+
+				OpaqueCount = (uint32_t)OpaqueKeys.size();
+				SortKeys.insert(SortKeys.begin(), OpaqueKeys.begin(), OpaqueKeys.end());
+				BuildBatches();
+				WriteBatches(workers);
+			}
+		}
+
+		//A layer shares one depth and the depth test keeps the first opaque quad drawn, so quads submitted later
+		//have to go first to stay on top like they do when drawn back to front
+		void ReverseOpaqueRuns()
+		{
+			size_t runStart = 0;
+			for (size_t i = 1; i <= OpaqueKeys.size(); i++)
+			{
+				if (i < OpaqueKeys.size() && OpaqueKeys[i] >> SortKey::TextureShift == OpaqueKeys[runStart] >> SortKey::TextureShift)
+					continue;
+
+				std::reverse(OpaqueKeys.begin() + runStart, OpaqueKeys.begin() + i);
+				runStart = i;
+			}
+
+#ifdef ENGINE_DEBUG
+			//Same as sorting the inverted order bits too, overlapping opaque sprites in a layer stack like the baseline
+			for (size_t i = 1; i < OpaqueKeys.size(); i++)
+				ME_ASSERT((OpaqueKeys[i - 1] < OpaqueKeys[i]), "Opaque quads are out of stacking order!");
+#endif
+		}
+
+		//Front to back only stacks right with a depth attachment to test against, without one every quad goes back to front.
+		//Both queues are in submission order, merging them on the order bits keeps it. Opaque chunks keep their reversed instances
+		void DropDepthOrder()
+		{
+			for (StaticDraw& draw : StaticDraws)
+				draw.Opaque = false;
+
+			if (OpaqueKeys.empty())
+				return;
+
+			for (uint64_t& key : OpaqueKeys)
+				key = ~key;
+
+			SortScratch.resize(SortKeys.size() + OpaqueKeys.size());
+			std::merge(SortKeys.begin(), SortKeys.end(), OpaqueKeys.begin(), OpaqueKeys.end(), SortScratch.begin(),
+				[](uint64_t a, uint64_t b) { return SortKey::Order(a) < SortKey::Order(b); });
+			SortKeys.swap(SortScratch);
+			OpaqueKeys.clear();
+		}
+
+		//Key of a queued quad in the plain layout, whichever queue it came from
+		uint64_t KeyAt(uint32_t index) const { return index < OpaqueCount ? ~SortKeys[index] : SortKeys[index]; }
+
+		void SortQuads(std::vector<uint64_t>& keys)
+		{
+			//LSD radix sort is stable and keys are pushed in submission order, so the order bits never need a pass
+			//Opaque keys come out ascending in submission order inside a run, ReverseOpaqueRuns flips them after
+			size_t count = keys.size();
+			if (count == 0)
+				return;
+
+			SortScratch.resize(count);
+
+			uint64_t* source = keys.data();
+			uint64_t* destination = SortScratch.data();
+
+			for (uint32_t shift = SortKey::TextureShift; shift < 64; shift += 8)
+			{
+				uint32_t histogram[256] = {};
+				for (size_t i = 0; i < count; i++)
+					histogram[(source[i] >> shift) & 0xff]++;
+
+				//Every key shares this digit, the pass would not move anything
+				if (histogram[(source[0] >> shift) & 0xff] == count)
+					continue;
+
+				uint32_t offset = 0;
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t digitCount = histogram[i];
+					histogram[i] = offset;
+					offset += digitCount;
+				}
+
+				for (size_t i = 0; i < count; i++)
+					destination[histogram[(source[i] >> shift) & 0xff]++] = source[i];
+
+				std::swap(source, destination);
+			}
+
+			if (source != keys.data())
+				keys.swap(SortScratch);
+		}
+
+		void BuildBatches()
+		{
+			uint32_t textureCount = (uint32_t)Textures.size();
+			if (TextureSlots.size() < textureCount)
+			{
+				TextureSlots.resize(textureCount, 0);
+				TextureBatches.resize(textureCount, 0);
+			}
+
+			//The batched path indexes into a fixed index buffer, instances only need the stream space
+			uint32_t maxBatchQuads = Mode == RenderMode::Instanced ? UINT32_MAX : MaxQuads;
+
+			for (const StreamChunk& chunk : QuadChunks)
+			{
+				uint32_t chunkEnd = chunk.First + chunk.Count;
+				uint32_t batchStart = chunk.First;
+
+				while (batchStart < chunkEnd)
+				{
+					//Grow the batch until it runs out of texture slots or quads, slot 0 is the white texture
+					uint32_t batchIndex = ++BatchIndex;
+					uint32_t textureStart = (uint32_t)BatchTextures.size();
+					uint32_t slotCount = 1;
+					uint32_t batchEnd = batchStart;
+
+					//Static chunks draw between layers, a batch must not cross a layer that has one of its pass
+					bool opaque = batchStart < OpaqueCount;
+					uint32_t passEnd = opaque ? std::min(chunkEnd, OpaqueCount) : chunkEnd;
+					uint32_t batchLayer = SortKey::Layer(KeyAt(batchStart));
+					uint32_t firstLayer = 0;
+					uint32_t splitLayer = UINT32_MAX;
+
+					auto opaqueEnd = StaticDraws.begin() + OpaqueStaticCount;
+					if (opaque)
+					{
+						auto nextStatic = std::find_if(StaticDraws.begin(), opaqueEnd, [batchLayer](const StaticDraw& draw) { return draw.Layer <= batchLayer; });
+						firstLayer = nextStatic != opaqueEnd ? nextStatic->Layer : 0;
+					}
+					else
+					{
+						auto nextStatic = std::upper_bound(opaqueEnd, StaticDraws.end(), batchLayer, [](uint32_t layer, const StaticDraw& draw) { return layer < draw.Layer; });
+						splitLayer = nextStatic != StaticDraws.end() ? nextStatic->Layer : UINT32_MAX;
+					}
+
+					while (batchEnd < passEnd && batchEnd - batchStart < maxBatchQuads)
+					{
+						uint64_t key = KeyAt(batchEnd);
+						uint32_t layer = SortKey::Layer(key);
+						if (layer < firstLayer || layer >= splitLayer)
+							break;
+
+						uint32_t textureKey = SortKey::Texture(key);
+						if (textureKey != 0 && TextureBatches[textureKey] != batchIndex)
+						{
+							if (slotCount >= MaxTextureSlots)
+							{
+								TextureSlotFlushes++;
+								break;
+							}
+
+							TextureBatches[textureKey] = batchIndex;
+							TextureSlots[textureKey] = slotCount;
+							BatchTextures.push_back(textureKey);
+							slotCount++;
+						}
+						batchEnd++;
+					}
+
+					QuadBatch& batch = Batches.emplace_back();
+					batch.Opaque = opaque;
+					batch.Layer = batchLayer;
+					batch.First = batchStart;
+					batch.Count = batchEnd - batchStart;
+					batch.TextureStart = textureStart;
+					batch.TextureCount = (uint32_t)BatchTextures.size() - textureStart;
+
+					uint32_t chunkIndex = batchStart - chunk.First;
+					if (Mode == RenderMode::Instanced)
+					{
+						batch.DrawOffset = chunk.Offset / sizeof(QuadInstance) + chunkIndex;
+						batch.Memory = (uint8_t*)((QuadInstance*)chunk.Memory + chunkIndex);
+					}
+					else
+					{
+						batch.DrawOffset = chunk.Offset / sizeof(QuadVertex) + chunkIndex * 4;
+						batch.Memory = (uint8_t*)((QuadVertex*)chunk.Memory + chunkIndex * 4);
+					}
+
+					batchStart = batchEnd;
+				}
+			}
+		}
+
+		//Every quad lands at the index the sort gave it, so the output is the same for any number of threads
+		void WriteBatches(WorkerPool& workers)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			for (uint32_t i = 0; i < (uint32_t)Batches.size(); i++)
+			{
+				const QuadBatch& batch = Batches[i];
+				for (uint32_t first = batch.First; first < batch.First + batch.Count; first += WriteRangeQuads)
+					WriteRanges.push_back({ i, first, std::min(batch.First + batch.Count - first, WriteRangeQuads) });
+			}
+
+			workers.Run((uint32_t)WriteRanges.size(), [this](uint32_t index)
+			{
+				const WriteRange& range = WriteRanges[index];
+				const QuadBatch& batch = Batches[range.Batch];
+				uint32_t offset = range.First - batch.First;
+
+				if (Mode == RenderMode::Instanced)
+					WriteQuadInstances(batch, range, (QuadInstance*)batch.Memory + offset);
+				else
+					WriteQuadVertices(batch, range, (QuadVertex*)batch.Memory + offset * 4);
+			});
+
+			WriteTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		//TextureSlots only holds the slots of the last batch built, ranges look theirs up in the batch instead
+		struct SlotLookup
+		{
+			const uint32_t* Textures;
+			uint32_t Count;
+			uint32_t LastKey = 0;
+			int32_t LastSlot = 0;
+
+			int32_t operator()(uint32_t textureKey)
+			{
+				if (textureKey == LastKey)
+					return LastSlot;
+
+				LastKey = textureKey;
+				LastSlot = 0;
+				for (uint32_t i = 0; i < Count; i++)
+					if (Textures[i] == textureKey)
+						LastSlot = (int32_t)i + 1;
+				return LastSlot;
+			}
+		};
+
+		void WriteQuadVertices(const QuadBatch& batch, const WriteRange& range, QuadVertex* quadVertices)
+		{
+			SlotLookup slots = { BatchTextures.data() + batch.TextureStart, batch.TextureCount };
+			for (uint32_t i = range.First; i < range.First + range.Count; i++)
+			{
+				uint64_t key = KeyAt(i);
+				const QuadCommand& quad = Quads[SortKey::Order(key)];
+				int32_t textureId = slots(quad.TextureKey);
+				float depth = LayerDepth(SortKey::Layer(key));
+
+				for (int v = 0; v < 4; v++)
+				{
+					QuadVertex& vertex = *quadVertices++;
+					vertex.Position = quad.Position + quad.AxisX * VertexPositions[v].x + quad.AxisY * VertexPositions[v].y;
+					vertex.Color = quad.Color;
+					vertex.TextureCoord = { TexCoords[v].x > 0.0f ? quad.TexRect.z : quad.TexRect.x, TexCoords[v].y > 0.0f ? quad.TexRect.w : quad.TexRect.y };
+					vertex.TextureId = textureId;
+					vertex.Tiling = quad.Tiling;
+					vertex.Depth = depth;
+				}
+			}
+		}
+
+		void WriteQuadInstances(const QuadBatch& batch, const WriteRange& range, QuadInstance* quadInstances)
+		{
+			SlotLookup slots = { BatchTextures.data() + batch.TextureStart, batch.TextureCount };
+			for (uint32_t i = range.First; i < range.First + range.Count; i++)
+			{
+				uint64_t key = KeyAt(i);
+				const QuadCommand& quad = Quads[SortKey::Order(key)];
+
+				QuadInstance& instance = *quadInstances++;
+				instance.Axes = { quad.AxisX.x, quad.AxisX.y, quad.AxisY.x, quad.AxisY.y };
+				instance.Position = quad.Position;
+				instance.Color = Maths::PackColor(quad.Color);
+				instance.TexRect = quad.TexRect;
+				instance.Tiling = quad.Tiling;
+				instance.TextureId = slots(quad.TextureKey);
+				instance.Depth = LayerDepth(SortKey::Layer(key));
+			}
+		}
+
+		void Reset()
+		{
+			Quads.clear();
+			SortKeys.clear();
+			OpaqueKeys.clear();
+			StaticDraws.clear();
+			OpaqueCount = 0;
+			OpaqueStaticCount = 0;
+			TextureKeys.clear();
+			TextureCache.clear();
+			Textures.resize(1);
+
+			QuadChunks.clear();
+			Batches.clear();
+			BatchTextures.clear();
+			WriteRanges.clear();
+			TextureSlotFlushes = 0;
+			WriteTime = 0.0f;
+		}
+	};
 
+	struct RenderData
+	{
 		//Renderer Data
 		glm::vec3 ClearColor = glm::vec3(0.0f);
 		glm::mat4 ViewProjection = glm::mat4(1.0f);
 
+		//Two packets, the front end records into one while the other is prepared and drawn
+		FramePacket Packets[2];
+		uint32_t RecordIndex = 0;
+		//Counts the packets handed over, tells chunk rebuilds which packet they are recorded into
+		uint64_t PacketSerial = 0;
+		FramePacket* Pending = nullptr;
+
+		Unique<RenderThread> Thread;
+		bool Threaded = true;
+		//Writes the stream of a prepared packet, the render thread joins in
+		Unique<WorkerPool> Workers;
+
+		//Counters of the frame being recorded, published by EndFrame
+		RendererStats Frame;
+		Unique<GpuTimer> Timer;
+		uint32_t Pass = 0;
+		std::vector<float> PassTimes;
+
+		//Frame uniform block, only uploaded when it changes
+		uint32_t FrameUniformBuffer = 0;
+		FrameUniforms UploadedUniforms;
+		bool FrameUniformsValid = false;
+		float ElapsedTime = 0.0f;
+
 		//Quad Renderer
 		uint32_t QuadVertexArray = 0;
-		uint32_t QuadVertexBuffer = 0;
+		uint32_t QuadInstanceArray = 0;
 		uint32_t QuadIndexBuffer = 0;
-		QuadLayerArray* QLayerArray = nullptr;
+		Unique<StreamBuffer> QuadStream;
+		RenderMode Mode = RenderMode::Instanced;
+		bool Overdraw = false;
 
 		Shared<Shader> QuadShader = nullptr;
+		Shared<Shader> InstanceShader = nullptr;
 		Shared<Texture> QuadTexture = nullptr;
 
-		int32_t TextureIds[32];
-		uint32_t TextureIndex = 0;
-		std::unordered_map<Shared<Texture>, int32_t> TextureCache;
 
-		//Line Renderer
-		uint32_t LineVertexArray = 0;
-		uint32_t LineVertexBuffer = 0;
+		TextureAtlas Atlas;
+
+		FramePacket& Recording() { return Packets[RecordIndex]; }
+
+		TextureEntry GetTextureFromCache(const Shared<Texture>& texture, const glm::vec2& tiling)
+		{
+			//Textures still streaming in draw white, and stay out of the atlas until their real pixels are there
+			if (!texture || !texture->IsLoaded())
+				return {};
 
-		LineVertex* LineVertices = nullptr;
-		uint32_t LineVertexIndex = 0;
+			FramePacket& packet = Recording();
 
-		Shared<Shader> LineShader = nullptr;
+			//Repeating needs the whole uv range of the texture, so tiled sprites keep sampling the original
+			if (tiling != glm::vec2(1.0f))
+				return { packet.GetTextureKey(texture) };
 
-		int32_t GetTextureFromCache(const Shared<Texture>& texture)
+			auto it = packet.TextureCache.find(texture);
+			if (it != packet.TextureCache.end())
+				return it->second;
+
+			TextureEntry entry;
+			if (const AtlasRegion* region = Atlas.GetRegion(texture))
+			{
+				entry.Key = packet.GetTextureKey(region->Page);
+				entry.Region = region->Rect;
+			}
+			else
+				entry.Key = packet.GetTextureKey(texture);
+
+			packet.TextureCache[texture] = entry;
+			return entry;
+		}
+
+		QuadCommand& SubmitQuad(int layer, uint32_t textureKey, bool opaque)
 		{
-			if (TextureCache.find(texture) != TextureCache.end())
-				return TextureCache.at(texture);
+			Frame.Quads++;
+			Frame.OpaqueQuads += opaque ? 1 : 0;
+			return Recording().SubmitQuad(layer, textureKey, opaque);
+		}
+
+		//Quads that fit in one stream region, one quad is kept for the alignment of the allocation
+		uint32_t GetChunkCapacity(RenderMode mode) const { return QuadStream->GetRegionSize() / GetQuadStride(mode) - 1; }
 
-			TextureIndex++;
-			texture->Bind(TextureIndex);
-			TextureCache[texture] = TextureIndex;
-			return TextureIndex;
+		//Texture keys belong to the packet, so this has to run before they are looked up
+		//A packet may fill all but one stream region before its draws are fenced, bigger frames are split into more packets
+		void ReserveQuads(uint32_t count)
+		{
+			if (Recording().Quads.size() + count > GetChunkCapacity(Mode) * (StreamRegions - 1))
+			{
+				Frame.Flushes[(size_t)FlushReason::QuadOverflow]++;
+				Renderer::End();
+			}
+		}
+
+		uint32_t GetPassIndex(const char* name, std::vector<RenderPassStats>& passes)
+		{
+			for (uint32_t i = 0; i < (uint32_t)passes.size(); i++)
+				if (passes[i].Name == name)
+					return i;
+
+			passes.emplace_back().Name = name;
+			PassTimes.push_back(0.0f);
+			return (uint32_t)passes.size() - 1;
 		}
 	};
 
 	static RenderData* s_Data;
+
 	RendererStats* Renderer::s_Stats = nullptr;
 
 	void Renderer::SetClearColor(const glm::vec3& color)
 	{
-		glClearColor(color.x, color.y, color.z, 1.0f);
+		RendererAPI::Get()->SetClearColor(color);
 		s_Data->ClearColor = color;
 	}
 
-	void Renderer::Init()
+	void Renderer::Init(RendererBackend backend)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-		glEnable(GL_LINE_SMOOTH);
+		RendererAPI::Create(backend);
+		RendererAPI* api = RendererAPI::Get();
 
 		s_Data = new RenderData();
 		s_Stats = new RendererStats();
-		s_Stats->MaxLayers = s_Data->MaxLayers;
+		s_Stats->MaxLayers = MaxLayers;
 
 		//+Quad Renderer Init
 
-		s_Data->QLayerArray = new QuadLayerArray[s_Data->MaxLayers];
-
-		for (int i = 0; i < s_Data->MaxLayers; i++)
-			s_Data->QLayerArray[i].QuadVertices = new QuadVertex[s_Data->MaxVertices];
+		//A region fits several full batches so a frame rarely has to wait on its own draws
+		s_Data->QuadStream = MakeUnique<StreamBuffer>(sizeof(QuadVertex) * MaxVertices * 4, StreamRegions);
 
-		uint32_t* indices = new uint32_t[s_Data->MaxIndices];
+		uint32_t* indices = new uint32_t[MaxIndices];
 		uint32_t indicesIndex = 0;
 
-		for (uint32_t i = 0; i < s_Data->MaxIndices; i += 6)
+		for (uint32_t i = 0; i < MaxIndices; i += 6)
 		{
 			indices[i + 0] = 0 + indicesIndex;
 			indices[i + 1] = 1 + indicesIndex;
@@ -138,330 +750,797 @@ namespace MoonEngine
 			indicesIndex += 4;
 		}
 
-		glGenVertexArrays(1, &s_Data->QuadVertexArray);
-		glGenBuffers(1, &s_Data->QuadVertexBuffer);
-		glGenBuffers(1, &s_Data->QuadIndexBuffer);
+		s_Data->QuadIndexBuffer = api->CreateBuffer(sizeof(uint32_t) * MaxIndices, indices);
+		delete[] indices;
 
-		glBindVertexArray(s_Data->QuadVertexArray);
+		s_Data->QuadVertexArray = api->CreateVertexArray(QuadVertexLayout, s_Data->QuadStream->GetBufferId(), s_Data->QuadIndexBuffer);
 
-		glBindBuffer(GL_ARRAY_BUFFER, s_Data->QuadVertexBuffer);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(QuadVertex) * s_Data->MaxVertices, nullptr, GL_DYNAMIC_DRAW);
+		//Instanced quads read the same stream, every attribute advances once per instance
+		s_Data->QuadInstanceArray = api->CreateVertexArray(QuadInstanceLayout, s_Data->QuadStream->GetBufferId(), s_Data->QuadIndexBuffer);
 
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), 0);
-		glEnableVertexAttribArray(0);
+		s_Data->QuadShader = MakeShared<Shader>("Resource/Shaders/Default.shader");
+		s_Data->InstanceShader = MakeShared<Shader>("Resource/Shaders/Instanced.shader");
 
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, Color));
-		glEnableVertexAttribArray(1);
+		s_Data->QuadTexture = MakeShared<Texture>();
 
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, TextureCoord));
-		glEnableVertexAttribArray(2);
+		for (FramePacket& packet : s_Data->Packets)
+		{
+			packet.Quads.reserve(MaxQuads);
+			packet.SortKeys.reserve(MaxQuads);
+			packet.OpaqueKeys.reserve(MaxQuads);
+			packet.TextureKeys.reserve(MaxTextureSlots);
+			packet.TextureCache.reserve(MaxTextureSlots);
+			packet.Reset();
+		}
 
-		glVertexAttribIPointer(3, 1, GL_INT, sizeof(QuadVertex), (void*)offsetof(QuadVertex, TextureId));
-		glEnableVertexAttribArray(3);
+		//-Quad Renderer Init
 
-		glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)offsetof(QuadVertex, Tiling));
-		glEnableVertexAttribArray(4);
+		s_Data->FrameUniformBuffer = api->CreateBuffer(sizeof(FrameUniforms));
+		api->BindUniformBuffer(FrameUniformBinding, s_Data->FrameUniformBuffer);
 
-		glVertexAttribIPointer(5, 1, GL_INT, sizeof(QuadVertex), (void*)offsetof(QuadVertex, EntityId));
-		glEnableVertexAttribArray(5);
+		DebugRenderer::Init();
+		TextureLoader::Init();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_Data->QuadIndexBuffer);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * s_Data->MaxIndices, indices, GL_STATIC_DRAW);
+		s_Data->Thread = MakeUnique<RenderThread>();
+		SetWriteThreads(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 8u));
+		s_Data->Timer = MakeUnique<GpuTimer>();
+		s_Data->Pass = s_Data->GetPassIndex("Scene", s_Stats->Passes);
+	}
 
-		delete[] indices;
+	void Renderer::Begin(const glm::mat4& viewProjection, const char* pass, bool clear)
+	{
+		if (clear)
+		{
+			//The clear has to land after the draws still queued for the same target
+			RendererAPI* api = RendererAPI::Get();
+			if (s_Data->Pending && s_Data->Pending->Target.Framebuffer == api->GetTarget().Framebuffer)
+				Flush();
 
-		glBindVertexArray(0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			//Overdraw accumulates on black so untouched pixels read as zero
+			if (s_Data->Overdraw)
+			{
+				api->SetClearColor(glm::vec3(0.0f));
+				api->Clear();
+				api->SetClearColor(s_Data->ClearColor);
+			}
+			else
+				api->Clear();
+		}
 
-		s_Data->QuadShader = MakeShared<Shader>("Resource/Shaders/Default.shader");
+		s_Data->ViewProjection = viewProjection;
+		s_Data->Pass = s_Data->GetPassIndex(pass, s_Stats->Passes);
 
-		s_Data->QuadTexture = MakeShared<Texture>();
-		for (int32_t i = 0; i < 32; i++)
-			s_Data->TextureIds[i] = i;
-		s_Data->TextureCache.reserve(32);
+		if (FrameCapture::IsCapturing())
+			FrameCapture::RecordBegin(viewProjection, pass, clear);
+	}
 
-		//-Quad Renderer Init
-		//+Line Renderer Init
+	void Renderer::End()
+	{
+		FramePacket& packet = s_Data->Recording();
+		s_Stats->AtlasPages = s_Data->Atlas.GetPageCount();
 
-		s_Data->LineVertices = new LineVertex[s_Data->MaxVertices];
+		if (FrameCapture::IsCapturing())
+			FrameCapture::RecordEnd();
 
-		glGenVertexArrays(1, &s_Data->LineVertexArray);
-		glGenBuffers(1, &s_Data->LineVertexBuffer);
+		if (packet.IsEmpty())
+			return;
 
-		glBindVertexArray(s_Data->LineVertexArray);
+		//Draws run later, so everything they depend on is captured now
+		packet.ViewProjection = s_Data->ViewProjection;
+		packet.Mode = s_Data->Mode;
+		packet.Overdraw = s_Data->Overdraw;
+		packet.Pass = s_Data->Pass;
+		packet.Target = RendererAPI::Get()->GetTarget();
 
-		glBindBuffer(GL_ARRAY_BUFFER, s_Data->LineVertexBuffer);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(LineVertex) * s_Data->MaxVertices, nullptr, GL_DYNAMIC_DRAW);
+		//Only one packet is in flight, drawing it first also keeps the stream fences ahead of the next allocation
+		Flush();
+		AllocateStreams(packet);
 
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), 0);
-		glEnableVertexAttribArray(0);
+		s_Data->Pending = &packet;
+		s_Data->RecordIndex ^= 1;
+		s_Data->PacketSerial++;
 
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, Color));
-		glEnableVertexAttribArray(1);
+		WorkerPool& workers = *s_Data->Workers;
+		if (s_Data->Threaded)
+			s_Data->Thread->Submit([&packet, &workers] { packet.Prepare(workers); });
+		else
+			packet.Prepare(workers);
+	}
 
-		glVertexAttribIPointer(2, 1, GL_INT, sizeof(LineVertex), (void*)offsetof(LineVertex, EntityId));
-		glEnableVertexAttribArray(2);
+	void Renderer::Flush()
+	{
+		//Framebuffers can outlive the renderer
+		if (!s_Data || !s_Data->Pending)
+			return;
 
-		s_Data->LineShader = MakeShared<Shader>("Resource/Shaders/Line.shader");
+		FramePacket* packet = s_Data->Pending;
 
-		//+Line Renderer Init
+		s_Data->Pending = nullptr;
+		if (s_Data->Threaded)
+			s_Data->Thread->Wait();
 
-	}
+		RendererAPI* api = RendererAPI::Get();
+		const RenderTarget& target = api->GetTarget();
+		api->SetTarget(packet->Target);
+		SetFrameUniforms(packet->ViewProjection);
 
-	void Renderer::Begin(const glm::mat4& viewProjection)
-	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		bool timed = s_Data->Timer->Begin(packet->Pass);
 
-		s_Data->ViewProjection = viewProjection;
+		if (!packet->Batches.empty() || !packet->StaticDraws.empty())
+			DrawQuads(*packet);
 
-		s_Data->TextureCache.clear();
-		s_Data->TextureIndex = 0;
+		if (timed)
+			s_Data->Timer->End();
 
-		s_Stats->DrawCalls = 0;
+		s_Data->Frame.Flushes[(size_t)FlushReason::TextureSlots] += packet->TextureSlotFlushes;
+		s_Data->Frame.WriteTime += packet->WriteTime;
+
+		s_Data->QuadStream->Fence();
+
+		api->SetTarget(target);
+
+		packet->Reset();
 	}
 
-	void Renderer::End()
+	void Renderer::AllocateStreams(FramePacket& packet)
 	{
-		s_Data->QuadShader->Bind();
-		s_Data->QuadShader->SetMat4("uVP", s_Data->ViewProjection);
-		s_Data->QuadShader->SetIntArray("uTexture", 32, s_Data->TextureIds);
-		s_Data->QuadTexture->Bind(0);
-		RenderIndexed();
-
-		if (s_Data->LineVertexIndex > 1)
+		//Stream allocations place fences, so they stay on the gl thread. Prepare only fills the memory
+		uint32_t quadCount = (uint32_t)packet.Quads.size();
+		if (quadCount > 0)
 		{
-			s_Data->LineShader->Bind();
-			s_Data->LineShader->SetMat4("uVP", s_Data->ViewProjection);
-
-			RenderLines();
+			uint32_t quadStride = GetQuadStride(packet.Mode);
+			uint32_t chunkCapacity = s_Data->GetChunkCapacity(packet.Mode);
 
-			s_Data->LineVertexIndex = 0;
+			for (uint32_t first = 0; first < quadCount; first += chunkCapacity)
+			{
+				StreamChunk& chunk = packet.QuadChunks.emplace_back();
+				chunk.First = first;
+				chunk.Count = std::min(quadCount - first, chunkCapacity);
+				chunk.Memory = (uint8_t*)s_Data->QuadStream->Allocate(chunk.Count * quadStride, quadStride, chunk.Offset);
+				s_Data->Frame.UploadBytes += chunk.Count * quadStride;
+			}
 		}
 	}
 
-	void Renderer::RenderIndexed(int layer)
+	void Renderer::DrawQuads(FramePacket& packet)
 	{
-		glBindVertexArray(s_Data->QuadVertexArray);
-		glBindBuffer(GL_ARRAY_BUFFER, s_Data->QuadVertexBuffer);
+		RendererAPI* api = RendererAPI::Get();
+		bool instanced = packet.Mode == RenderMode::Instanced;
 
-		if (layer > -1 && layer < s_Data->MaxLayers)
+		//Static chunks always use the instanced shader, the streamed quads follow the render mode
+		Shader* boundShader = nullptr;
+		auto bindShader = [&](const Shared<Shader>& shader)
 		{
-			s_Data->QuadShader->Bind();
-			s_Data->QuadShader->SetMat4("uVP", s_Data->ViewProjection);
-			s_Data->QuadShader->SetIntArray("uTexture", 32, s_Data->TextureIds);
-			s_Data->QuadTexture->Bind(0);
+			if (boundShader == shader.get())
+				return;
+
+			boundShader = shader.get();
+			shader->Bind();
+			s_Data->Frame.ShaderBinds++;
+		};
 
-			if (s_Data->QLayerArray[layer].QuadVertexIndex >= 4)
+		s_Data->QuadTexture->Bind(0);
+		s_Data->Frame.TextureBinds++;
+
+		auto setAlphaCutoff = [&](float cutoff)
+		{
+			s_Data->QuadShader->SetFloat(AlphaCutoffUniform, cutoff);
+			s_Data->InstanceShader->SetFloat(AlphaCutoffUniform, cutoff);
+		};
+
+		s_Data->QuadShader->SetInt(OverdrawUniform, packet.Overdraw);
+		s_Data->InstanceShader->SetInt(OverdrawUniform, packet.Overdraw);
+		if (packet.Overdraw)
+			api->SetBlendMode(BlendMode::Additive);
+
+		//Opaque statics lead the list front to back and draw down to the layer given, the translucent ones follow back to front up to it
+		size_t staticIndex = 0;
+		auto drawStatic = [&](bool opaque, uint32_t layer)
+		{
+			size_t staticEnd = opaque ? packet.OpaqueStaticCount : packet.StaticDraws.size();
+			for (; staticIndex < staticEnd; staticIndex++)
 			{
-				uint32_t quadQuadVertexIndex = s_Data->QLayerArray[layer].QuadVertexIndex;
+				uint32_t drawLayer = packet.StaticDraws[staticIndex].Layer;
+				if (opaque ? drawLayer < layer : drawLayer > layer)
+					break;
+
+				const StaticDraw& draw = packet.StaticDraws[staticIndex];
+				bindShader(s_Data->InstanceShader);
 
-				glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(QuadVertex) * quadQuadVertexIndex, s_Data->QLayerArray[layer].QuadVertices);
-				glDrawElements(GL_TRIANGLES, (GLsizei)quadQuadVertexIndex * 1.5f, GL_UNSIGNED_INT, 0);
-				s_Stats->DrawCalls++;
+				if (draw.Texture)
+				{
+					draw.Texture->Bind(1);
+					s_Data->Frame.TextureBinds++;
+				}
+
+				api->DrawIndexedInstanced(draw.VertexArray, 6, draw.InstanceCount, 0);
+				s_Data->Frame.DrawCalls++;
 			}
-			s_Data->QLayerArray[layer].QuadVertexIndex = 0;
+		};
 
-			return;
-		}
+		//Opaque quads go front to back and write depth, so whatever they hide is rejected before shading
+		api->SetDepthMode(DepthMode::TestWrite);
+		setAlphaCutoff(OpaqueAlphaCutoff);
 
-		for (uint32_t i = 0; i < s_Data->MaxLayers; i++)
+		auto beginTranslucent = [&]()
 		{
-			if (s_Data->QLayerArray[i].QuadVertexIndex >= 4)
-			{
-				uint32_t quadQuadVertexIndex = s_Data->QLayerArray[i].QuadVertexIndex;
+			drawStatic(true, 0);
+			api->SetDepthMode(DepthMode::Test);
+			setAlphaCutoff(0.0f);
+		};
 
-				glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(QuadVertex) * quadQuadVertexIndex, s_Data->QLayerArray[i].QuadVertices);
-				glDrawElements(GL_TRIANGLES, quadQuadVertexIndex * 1.5f, GL_UNSIGNED_INT, 0);
-				s_Stats->DrawCalls++;
+		bool opaquePass = true;
+		for (const QuadBatch& batch : packet.Batches)
+		{
+			if (opaquePass && !batch.Opaque)
+			{
+				beginTranslucent();
+				opaquePass = false;
 			}
-			s_Data->QLayerArray[i].QuadVertexIndex = 0;
+
+			//Streamed quads cover static chunks of their own layer, so opaque chunks wait for the layer below
+			drawStatic(opaquePass, opaquePass ? batch.Layer + 1 : batch.Layer);
+
+			bindShader(instanced ? s_Data->InstanceShader : s_Data->QuadShader);
+
+			for (uint32_t i = 0; i < batch.TextureCount; i++)
+				packet.Textures[packet.BatchTextures[batch.TextureStart + i]]->Bind(i + 1);
+			s_Data->Frame.TextureBinds += batch.TextureCount;
+
+			//Instances reuse the first six indices of the quad index buffer
+			if (instanced)
+				api->DrawIndexedInstanced(s_Data->QuadInstanceArray, 6, batch.Count, batch.DrawOffset);
+			else
+				api->DrawIndexed(s_Data->QuadVertexArray, batch.Count * 6, batch.DrawOffset);
+
+			s_Data->Frame.DrawCalls++;
 		}
+
+		if (opaquePass)
+			beginTranslucent();
+
+		drawStatic(false, UINT32_MAX);
+
+		api->SetDepthMode(DepthMode::Off);
+		if (packet.Overdraw)
+			api->SetBlendMode(BlendMode::Alpha);
 	}
 
-	void Renderer::RenderLines()
+	void Renderer::SetFrameUniforms(const glm::mat4& viewProjection)
 	{
-		glBindVertexArray(s_Data->LineVertexArray);
-		glBindBuffer(GL_ARRAY_BUFFER, s_Data->LineVertexBuffer);
+		RendererAPI* api = RendererAPI::Get();
+		const RenderTarget& target = api->GetTarget();
+
+		FrameUniforms uniforms;
+		uniforms.ViewProjection = viewProjection;
+		uniforms.ViewportSize = { (float)target.Viewport[2], (float)target.Viewport[3] };
+		uniforms.Time = s_Data->ElapsedTime;
+		uniforms.Padding = 0.0f;
 
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(LineVertex) * s_Data->LineVertexIndex, s_Data->LineVertices);
+		//Passes drawn back to back with the same camera upload once
+		if (s_Data->FrameUniformsValid && memcmp(&uniforms, &s_Data->UploadedUniforms, sizeof(FrameUniforms)) == 0)
+			return;
 
-		glDrawArrays(GL_LINES, 0, s_Data->LineVertexIndex);
-		s_Stats->DrawCalls++;
+		api->UpdateBuffer(s_Data->FrameUniformBuffer, &uniforms, sizeof(FrameUniforms));
+		s_Data->UploadedUniforms = uniforms;
+		s_Data->FrameUniformsValid = true;
+		s_Data->Frame.UploadBytes += sizeof(FrameUniforms);
+	}
+
+	void Renderer::EndFrame()
+	{
+		Flush();
+		s_Data->ElapsedTime += Time::DeltaTime();
+		s_Data->Atlas.Collect();
+
+		//Results of a pass can arrive over several frames, whatever finished since the last frame is reported
+		std::vector<float>& passTimes = s_Data->PassTimes;
+		std::fill(passTimes.begin(), passTimes.end(), -1.0f);
+		s_Data->Timer->Collect([&](uint32_t pass, float milliseconds)
+		{
+			passTimes[pass] = std::max(passTimes[pass], 0.0f) + milliseconds;
+		});
+
+		RendererStats& frame = s_Data->Frame;
+		RendererStats& stats = *s_Stats;
+		DebugRenderer::EndFrame(frame);
+		TextureLoader::Update(frame);
+		FrameCapture::EndFrame();
+
+		stats.Frame++;
+		stats.DrawCalls = frame.DrawCalls;
+		stats.Quads = frame.Quads;
+		stats.StaticQuads = frame.StaticQuads;
+		stats.OpaqueQuads = frame.OpaqueQuads;
+		stats.Lines = frame.Lines;
+		stats.UploadBytes = frame.UploadBytes;
+		stats.TextureBinds = frame.TextureBinds;
+		stats.ShaderBinds = frame.ShaderBinds;
+		stats.WriteTime = frame.WriteTime;
+		memcpy(stats.Flushes, frame.Flushes, sizeof(stats.Flushes));
+		frame = RendererStats();
+
+		RenderTargetPool::Update(stats);
+
+		for (uint32_t i = 0; i < (uint32_t)stats.Passes.size(); i++)
+		{
+			RenderPassStats& pass = stats.Passes[i];
+			if (passTimes[i] >= 0.0f)
+				pass.GpuTime = passTimes[i];
+			pass.GpuTimeHistory[stats.HistoryOffset] = pass.GpuTime;
+		}
+
+		stats.DrawCallHistory[stats.HistoryOffset] = (float)stats.DrawCalls;
+		stats.HistoryOffset = (stats.HistoryOffset + 1) % RenderPassStats::HistorySize;
 	}
 
 	//+Quad Renderer
 
-	void Renderer::DrawEntity(const TransformComponent& tC, const SpriteComponent& sC, int entityId)
+	void Renderer::DrawEntity(const TransformComponent& tC, const SpriteComponent& sC)
 	{
 		const glm::mat4& rotationMat = glm::toMat4(glm::quat(tC.Rotation));
 		const glm::mat4& transform = glm::translate(glm::mat4(1.0f), tC.Position) * rotationMat * glm::scale(glm::mat4(1.0f), tC.Scale);
 
-		if(!sC.GetTextureSheet())
-			DrawEntity(transform, sC.Color, sC.GetTexture(), sC.Layer, sC.Tiling, entityId);
+		if (sC.Animated)
+			DrawQuad(transform, sC.Color, sC.GetTexture(), sC.FrameRect, sC.Layer, sC.Tiling);
+		else if(!sC.GetTextureSheet())
+			DrawEntity(transform, sC.Color, sC.GetTexture(), sC.Layer, sC.Tiling);
 		else
-			DrawEntity(transform, sC.Color, sC.GetTextureSheet(), sC.Layer, sC.Tiling, entityId);
+			DrawEntity(transform, sC.Color, sC.GetTextureSheet(), sC.Layer, sC.Tiling);
 
 	}
 
-	void Renderer::DrawEntity(const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation, const glm::vec4& color, const Shared<Texture>& texture, int layer, const glm::vec2& tiling, int entityId)
+	void Renderer::DrawEntity(const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation, const glm::vec4& color, const Shared<Texture>& texture, int layer, const glm::vec2& tiling)
 	{
 		const glm::mat4& rotationMat = glm::toMat4(glm::quat(rotation));
 		const glm::mat4& transform = glm::translate(glm::mat4(1.0f), position) * rotationMat * glm::scale(glm::mat4(1.0f), scale);
 
-		DrawEntity(transform, color, texture, layer, tiling, entityId);
+		DrawEntity(transform, color, texture, layer, tiling);
 	}
 
-	void Renderer::DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, int layer, const glm::vec2& tiling, int entityId)
+	void Renderer::DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, int layer, const glm::vec2& tiling)
 	{
-		bool layerException = layer < 0 || layer >= s_Data->MaxLayers;
-		ME_ASSERT(!layerException, "Layer out of bounds!");
+		DrawQuad(transform, color, texture, { 0.0f, 0.0f, 1.0f, 1.0f }, layer, tiling);
+	}
 
-		if (s_Data->QLayerArray[layer].QuadVertexIndex >= s_Data->MaxVertices)
-			End();
+	void Renderer::DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<TextureSheet>& spriteSheet, int layer, const glm::vec2& tiling)
+	{
+		if (!spriteSheet)
+			DrawQuad(transform, color, Shared<Texture>(), { 0.0f, 0.0f, 1.0f, 1.0f }, layer, tiling);
+		else
+			DrawQuad(transform, color, spriteSheet->GetTexture(), { spriteSheet->GetTexCoord(0), spriteSheet->GetTexCoord(2) }, layer, tiling);
+	}
+
+	void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, const glm::vec4& texRect, int layer, const glm::vec2& tiling)
+	{
+		if (FrameCapture::IsCapturing())
+			FrameCapture::RecordQuad(transform, color, texture, texRect, layer, tiling);
+
+		s_Data->ReserveQuads(1);
+		const TextureEntry& entry = s_Data->GetTextureFromCache(texture, tiling);
+
+		QuadCommand& quad = s_Data->SubmitQuad(layer, entry.Key, IsOpaque(texture, color));
+		quad.AxisX = transform[0];
+		quad.AxisY = transform[1];
+		quad.Position = transform[3];
+		quad.Color = color;
+		quad.TexRect = entry.Remap(texRect);
+		quad.Tiling = tiling;
+	}
 
-		if (s_Data->TextureIndex >= 32)
+	void Renderer::SubmitSprites(const TransformComponent* const* transforms, const SpriteComponent* const* sprites, uint32_t count)
+	{
+		SpriteRenderItem items[SpriteBlockSize];
+		SpriteRenderItem* itemPointers[SpriteBlockSize];
+		for (uint32_t i = 0; i < count; i++)
+			itemPointers[i] = &items[i];
+
+		BuildSpriteItems(transforms, sprites, itemPointers, count);
+		SubmitSpriteItems(itemPointers, count);
+	}
+
+	//Animated sprites sample the current frame of their own texture instead of the sheet cell
+	static void ResolveSpriteTexture(const SpriteComponent& sprite, SpriteRenderItem& item)
+	{
+		const TextureSheet* spriteSheet = sprite.Animated ? nullptr : sprite.GetTextureSheet().get();
+
+		if (sprite.Animated)
 		{
-			End();
-			s_Data->TextureCache.clear();
-			s_Data->TextureIndex = 0;
+			item.Texture = sprite.GetTexture();
+			item.TexRect = sprite.FrameRect;
+		}
+		else if (spriteSheet)
+		{
+			item.Texture = spriteSheet->GetTexture();
+			item.TexRect = { spriteSheet->GetTexCoord(0), spriteSheet->GetTexCoord(2) };
+		}
+		else
+		{
+			item.Texture = sprite.GetTexture();
+			item.TexRect = { 0.0f, 0.0f, 1.0f, 1.0f };
 		}
+	}
 
-		uint32_t vertexIndex = s_Data->QLayerArray[layer].QuadVertexIndex;
-		const QuadLayerArray& layerArray = s_Data->QLayerArray[layer];
-		int32_t textureId = 0;
-		if (texture)
-			textureId = s_Data->GetTextureFromCache(texture);
+	void Renderer::BuildSpriteItems(const TransformComponent* const* transforms, const SpriteComponent* const* sprites, SpriteRenderItem* const* items, uint32_t count)
+	{
+		//Sprites rotated around x or y still need the full transform, the rest are gathered for the batched sincos
+		uint32_t flatSprites[SpriteBlockSize];
+		uint32_t flatCount = 0;
 
-		for (int i = 0; i < 4; i++)
+		for (uint32_t i = 0; i < count; i++)
 		{
-			layerArray.QuadVertices[vertexIndex + i].Position = transform * VertexPositions[i];
-			layerArray.QuadVertices[vertexIndex + i].Color = color;
-			layerArray.QuadVertices[vertexIndex + i].TextureCoord = TexCoords[i];
-			layerArray.QuadVertices[vertexIndex + i].Tiling = tiling;
-			layerArray.QuadVertices[vertexIndex + i].EntityId = entityId;
-			layerArray.QuadVertices[vertexIndex + i].TextureId = textureId;
+			const TransformComponent& transform = *transforms[i];
+			const SpriteComponent& sprite = *sprites[i];
+			SpriteRenderItem& item = *items[i];
+
+			item.Color = sprite.Color;
+			item.Tiling = sprite.Tiling;
+			item.Layer = sprite.Layer;
+			ResolveSpriteTexture(sprite, item);
+
+			if (transform.Rotation.x == 0.0f && transform.Rotation.y == 0.0f)
+			{
+				flatSprites[flatCount++] = i;
+				continue;
+			}
+
+			const glm::mat4& rotationMat = glm::toMat4(glm::quat(transform.Rotation));
+			const glm::mat4& matrix = glm::translate(glm::mat4(1.0f), transform.Position) * rotationMat * glm::scale(glm::mat4(1.0f), transform.Scale);
+			item.AxisX = matrix[0];
+			item.AxisY = matrix[1];
+			item.Position = matrix[3];
 		}
 
-		s_Data->QLayerArray[layer].QuadVertexIndex += 4;
+		for (uint32_t first = 0; first < flatCount; first += 4)
+		{
+			float angles[4] = {};
+			float sines[4];
+			float cosines[4];
+
+			uint32_t laneCount = std::min(flatCount - first, 4u);
+			for (uint32_t lane = 0; lane < laneCount; lane++)
+				angles[lane] = transforms[flatSprites[first + lane]]->Rotation.z;
+
+			Maths::SinCos4(angles, sines, cosines);
+
+			for (uint32_t lane = 0; lane < laneCount; lane++)
+			{
+				uint32_t index = flatSprites[first + lane];
+				const TransformComponent& transform = *transforms[index];
+				SpriteRenderItem& item = *items[index];
+
+				item.AxisX = { cosines[lane] * transform.Scale.x, sines[lane] * transform.Scale.x, 0.0f };
+				item.AxisY = { -sines[lane] * transform.Scale.y, cosines[lane] * transform.Scale.y, 0.0f };
+				item.Position = transform.Position;
+			}
+		}
 	}
 
-	void Renderer::DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<TextureSheet>& spriteSheet, int layer, const glm::vec2& tiling, int entityId)
+	void Renderer::SubmitSpriteItems(const SpriteRenderItem* const* items, uint32_t count)
 	{
-		bool layerException = layer < 0 || layer >= s_Data->MaxLayers;
-		ME_ASSERT(!layerException, "Layer out of bounds!");
+		s_Data->ReserveQuads(count);
 
-		if (s_Data->QLayerArray[layer].QuadVertexIndex >= s_Data->MaxVertices)
-			End();
+		//Neighbouring sprites usually share a texture, remember the last lookup to skip the hash map
+		const Texture* lastTexture = nullptr;
+		TextureEntry lastEntry;
 
-		if (s_Data->TextureIndex >= 32)
+		for (uint32_t i = 0; i < count; i++)
 		{
-			End();
-			s_Data->TextureCache.clear();
-			s_Data->TextureIndex = 0;
+			const SpriteRenderItem& item = *items[i];
+
+			TextureEntry entry;
+			if (item.Tiling != glm::vec2(1.0f))
+				entry = s_Data->GetTextureFromCache(item.Texture, item.Tiling);
+			else
+			{
+				if (item.Texture.get() != lastTexture)
+				{
+					lastTexture = item.Texture.get();
+					lastEntry = s_Data->GetTextureFromCache(item.Texture, item.Tiling);
+				}
+				entry = lastEntry;
+			}
+
+			if (FrameCapture::IsCapturing())
+			{
+				glm::mat4 transform = glm::mat4(1.0f);
+				transform[0] = glm::vec4(item.AxisX, 0.0f);
+				transform[1] = glm::vec4(item.AxisY, 0.0f);
+				transform[3] = glm::vec4(item.Position, 1.0f);
+				FrameCapture::RecordQuad(transform, item.Color, item.Texture, item.TexRect, item.Layer, item.Tiling);
+			}
+
+			QuadCommand& quad = s_Data->SubmitQuad(item.Layer, entry.Key, IsOpaque(item.Texture, item.Color));
+			quad.AxisX = item.AxisX;
+			quad.AxisY = item.AxisY;
+			quad.Position = item.Position;
+			quad.Color = item.Color;
+			quad.TexRect = entry.Remap(item.TexRect);
+			quad.Tiling = item.Tiling;
 		}
+	}
 
-		uint32_t vertexIndex = s_Data->QLayerArray[layer].QuadVertexIndex;
+	void Renderer::DrawSprites(const SpriteQuery& query)
+	{
+		const std::vector<const SpriteRenderItem*>& items = *query.Items;
+		for (uint32_t first = 0; first < (uint32_t)items.size(); first += SpriteBlockSize)
+			SubmitSpriteItems(items.data() + first, std::min((uint32_t)items.size() - first, SpriteBlockSize));
+	}
 
-		const QuadLayerArray& layerArray = s_Data->QLayerArray[layer];
+	void Renderer::DrawStaticBatch(StaticBatch& batch, const glm::vec2& viewMin, const glm::vec2& viewMax)
+	{
+		FramePacket& packet = s_Data->Recording();
 
-		int32_t textureId = 0;
-		if (spriteSheet)
+		for (StaticBatch::StaticChunk& chunk : batch.m_Chunks)
 		{
-			Shared<Texture> texture = spriteSheet->GetTexture();
+			if (chunk.Keys.empty())
+				continue;
+
+			if (chunk.Dirty || (chunk.WaitingTexture && chunk.SourceTexture->IsLoaded()))
+				RebuildStaticChunk(batch, chunk);
 
-			if (texture)
-				textureId = s_Data->GetTextureFromCache(texture);
+			if (chunk.Max.x < viewMin.x || chunk.Min.x > viewMax.x || chunk.Max.y < viewMin.y || chunk.Min.y > viewMax.y)
+				continue;
+
+			s_Data->Frame.StaticQuads += chunk.InstanceCount;
+
+			StaticDraw& draw = packet.StaticDraws.emplace_back();
+			draw.Opaque = chunk.Opaque;
+			draw.Layer = (uint32_t)std::clamp(chunk.Layer, 0, (int)MaxLayers - 1);
+			draw.VertexArray = chunk.Buffer.GetVertexArray();
+			draw.InstanceCount = chunk.InstanceCount;
+			draw.Texture = chunk.DrawTexture;
 		}
+	}
 
-		for (int i = 0; i < 4; i++)
+	//Picks the copy of the chunk buffer to rebuild into and uploads the instances
+	static void UploadChunk(ChunkBuffer& buffer, const std::vector<QuadInstance>& instances, uint32_t capacity)
+	{
+		RendererAPI* api = RendererAPI::Get();
+		if (!buffer.Buffers[0])
 		{
-			layerArray.QuadVertices[vertexIndex + i].Position = transform * VertexPositions[i];
-			layerArray.QuadVertices[vertexIndex + i].Color = color;
-			layerArray.QuadVertices[vertexIndex + i].Tiling = tiling;
-			layerArray.QuadVertices[vertexIndex + i].EntityId = entityId;
-			layerArray.QuadVertices[vertexIndex + i].TextureId = textureId;
+			for (uint32_t i = 0; i < 2; i++)
+			{
+				buffer.Buffers[i] = api->CreateBuffer(sizeof(QuadInstance) * capacity);
+				buffer.VertexArrays[i] = api->CreateVertexArray(QuadInstanceLayout, buffer.Buffers[i], s_Data->QuadIndexBuffer);
+			}
+		}
 
-			if (spriteSheet)
-				layerArray.QuadVertices[vertexIndex + i].TextureCoord = spriteSheet->GetTexCoord(i);
+		//The packet waiting to be drawn reads the current copy, unless the chunk was already rebuilt in the one still recording.
+		//Writing the other copy keeps that packet intact without flushing it early
+		if (buffer.Packet != s_Data->PacketSerial)
+		{
+			buffer.Current ^= 1;
+			buffer.Packet = s_Data->PacketSerial;
 		}
 
-		s_Data->QLayerArray[layer].QuadVertexIndex += 4;
+		api->UpdateBuffer(buffer.Buffers[buffer.Current], instances.data(), sizeof(QuadInstance) * (uint32_t)instances.size());
+		s_Data->Frame.UploadBytes += sizeof(QuadInstance) * instances.size();
 	}
 
-	//-Quad Renderer
-	//+Line Renderer
+	void Renderer::RebuildStaticChunk(StaticBatch& batch, StaticBatch::StaticChunk& chunk)
+	{
+		//Every sprite of the chunk shares one texture, bound to slot 1 when drawn
+		TextureEntry entry;
+		chunk.DrawTexture = nullptr;
+		chunk.WaitingTexture = chunk.SourceTexture && !chunk.SourceTexture->IsLoaded();
+		if (chunk.SourceTexture && !chunk.WaitingTexture)
+		{
+			const AtlasRegion* region = chunk.Tiled ? nullptr : s_Data->Atlas.GetRegion(chunk.SourceTexture);
+			chunk.DrawTexture = region ? region->Page : chunk.SourceTexture;
+			entry.Key = 1;
+			if (region)
+				entry.Region = region->Rect;
+		}
+
+		//Opaque chunks are written in reverse so the depth test keeps the sprite added last on top
+		chunk.Opaque = !chunk.SourceTexture || chunk.SourceTexture->GetAlphaMode() != AlphaMode::Translucent;
+		for (uint32_t key : chunk.Keys)
+			chunk.Opaque &= batch.m_Sprites.at(key).Color.a >= 1.0f;
+
+		float depth = LayerDepth((uint32_t)std::clamp(chunk.Layer, 0, (int)MaxLayers - 1));
+		size_t lastInstance = chunk.Keys.size() - 1;
+
+		std::vector<QuadInstance> instances(chunk.Keys.size());
+		chunk.Min = glm::vec2(std::numeric_limits<float>::max());
+		chunk.Max = glm::vec2(std::numeric_limits<float>::lowest());
+
+		for (size_t i = 0; i < chunk.Keys.size(); i++)
+		{
+			const StaticBatch::StaticSprite& sprite = batch.m_Sprites.at(chunk.Keys[i]);
+			const glm::mat4& transform = glm::translate(glm::mat4(1.0f), sprite.Position) * glm::toMat4(glm::quat(sprite.Rotation)) * glm::scale(glm::mat4(1.0f), sprite.Scale);
+
+			QuadInstance& instance = instances[chunk.Opaque ? lastInstance - i : i];
+			instance.Axes = { transform[0].x, transform[0].y, transform[1].x, transform[1].y };
+			instance.Position = transform[3];
+			instance.Color = Maths::PackColor(sprite.Color);
+			instance.TexRect = entry.Remap(sprite.Sheet ? glm::vec4(sprite.Sheet->GetTexCoord(0), sprite.Sheet->GetTexCoord(2)) : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+			instance.Tiling = sprite.Tiling;
+			instance.TextureId = (int32_t)entry.Key;
+			instance.Depth = depth;
+
+			glm::vec2 extents = (glm::abs(glm::vec2(transform[0])) + glm::abs(glm::vec2(transform[1]))) * 0.5f;
+			chunk.Min = glm::min(chunk.Min, glm::vec2(transform[3]) - extents);
+			chunk.Max = glm::max(chunk.Max, glm::vec2(transform[3]) + extents);
+		}
+
+		UploadChunk(chunk.Buffer, instances, StaticBatch::ChunkCapacity);
+		chunk.InstanceCount = (uint32_t)instances.size();
+		chunk.Dirty = false;
+	}
 
-	void Renderer::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityId)
+	void Renderer::DrawTilemap(const TransformComponent& transform, TilemapComponent& tilemap, const glm::vec2& viewMin, const glm::vec2& viewMax)
 	{
-		uint32_t vertexIndex = s_Data->LineVertexIndex;
+		FramePacket& packet = s_Data->Recording();
+		Tilemap& tiles = tilemap.Tiles;
 
-		if (vertexIndex >= s_Data->MaxVertices)
-			End();
+		const glm::mat4& matrix = glm::translate(glm::mat4(1.0f), transform.Position) * glm::toMat4(glm::quat(transform.Rotation)) * glm::scale(glm::mat4(1.0f), transform.Scale);
+		tiles.SetBakeState(matrix, tilemap.Tileset, tilemap.TileSize, tilemap.Color, tilemap.Layer);
+
+		for (Tilemap::TileChunk& chunk : tiles.m_Chunks)
+		{
+			if (chunk.TileCount == 0)
+				continue;
+
+			if (chunk.Dirty || (chunk.WaitingTexture && tiles.m_Tileset->IsLoaded()))
+				RebuildTilemapChunk(tiles, chunk);
+
+			if (chunk.Max.x < viewMin.x || chunk.Min.x > viewMax.x || chunk.Max.y < viewMin.y || chunk.Min.y > viewMax.y)
+				continue;
+
+			s_Data->Frame.StaticQuads += chunk.InstanceCount;
+
+			StaticDraw& draw = packet.StaticDraws.emplace_back();
+			draw.Opaque = chunk.Opaque;
+			draw.Layer = (uint32_t)std::clamp(tiles.m_Layer, 0, (int)MaxLayers - 1);
+			draw.VertexArray = chunk.Buffer.GetVertexArray();
+			draw.InstanceCount = chunk.InstanceCount;
+			draw.Texture = chunk.DrawTexture;
+		}
+	}
+
+	void Renderer::RebuildTilemapChunk(Tilemap& tilemap, Tilemap::TileChunk& chunk)
+	{
+		const Shared<Texture>& tileset = tilemap.m_Tileset;
+		TextureEntry entry;
+		chunk.DrawTexture = nullptr;
+		chunk.WaitingTexture = tileset && !tileset->IsLoaded();
+		if (tileset && !chunk.WaitingTexture)
+		{
+			const AtlasRegion* region = s_Data->Atlas.GetRegion(tileset);
+			chunk.DrawTexture = region ? region->Page : tileset;
+			entry.Key = 1;
+			if (region)
+				entry.Region = region->Rect;
+		}
+
+		//Cells are counted from the top row of the tileset, a tileset still loading draws every tile white
+		glm::vec2 cellUV = tileset ? tilemap.m_TileSize / glm::vec2(tileset->GetWidth(), tileset->GetHeight()) : glm::vec2(1.0f);
+		uint32_t columns = cellUV.x > 0.0f ? std::max((uint32_t)(1.0f / cellUV.x), 1u) : 1;
+		uint32_t rows = cellUV.y > 0.0f ? std::max((uint32_t)(1.0f / cellUV.y), 1u) : 1;
+
+		const glm::mat4& transform = tilemap.m_Transform;
+		uint32_t colorValue = Maths::PackColor(tilemap.m_Color);
+		float depth = LayerDepth((uint32_t)std::clamp(tilemap.m_Layer, 0, (int)MaxLayers - 1));
+		chunk.Opaque = tilemap.m_Color.a >= 1.0f && (!tileset || tileset->GetAlphaMode() != AlphaMode::Translucent);
 
-		s_Data->LineVertices[vertexIndex].Position = p0;
-		s_Data->LineVertices[vertexIndex].Color = color;
-		s_Data->LineVertices[vertexIndex].EntityId = entityId;
-		vertexIndex++;
+		std::vector<QuadInstance> instances;
+		instances.reserve(chunk.TileCount);
+
+		glm::vec2 origin = glm::vec2(chunk.Coord * Tilemap::ChunkSize);
+		for (uint32_t i = 0; i < Tilemap::ChunkTiles; i++)
+		{
+			uint16_t tile = chunk.Tiles[i];
+			if (tile == Tilemap::EmptyTile)
+				continue;
+
+			uint32_t index = tile - 1u;
+			glm::vec2 cell = { (float)(index % columns), (float)(rows - 1 - (index / columns) % rows) };
+			glm::vec2 center = origin + glm::vec2(i % Tilemap::ChunkSize, i / Tilemap::ChunkSize) + 0.5f;
+
+			QuadInstance& instance = instances.emplace_back();
+			instance.Axes = { transform[0].x, transform[0].y, transform[1].x, transform[1].y };
+			instance.Position = transform * glm::vec4(center, 0.0f, 1.0f);
+			instance.Color = colorValue;
+			instance.TexRect = entry.Remap(tileset ? glm::vec4(cell * cellUV, (cell + 1.0f) * cellUV) : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+			instance.Tiling = glm::vec2(1.0f);
+			instance.TextureId = (int32_t)entry.Key;
+			instance.Depth = depth;
+		}
+
+		//Bounds of the whole chunk square, cheaper than tracking the occupied tiles and just as good for culling
+		chunk.Min = glm::vec2(std::numeric_limits<float>::max());
+		chunk.Max = glm::vec2(std::numeric_limits<float>::lowest());
+		for (int corner = 0; corner < 4; corner++)
+		{
+			glm::vec2 local = origin + glm::vec2(corner & 1, corner >> 1) * (float)Tilemap::ChunkSize;
+			glm::vec2 world = transform * glm::vec4(local, 0.0f, 1.0f);
+			chunk.Min = glm::min(chunk.Min, world);
+			chunk.Max = glm::max(chunk.Max, world);
+		}
 
-		s_Data->LineVertices[vertexIndex].Position = p1;
-		s_Data->LineVertices[vertexIndex].Color = color;
-		s_Data->LineVertices[vertexIndex].EntityId = entityId;
-		vertexIndex++;
+		UploadChunk(chunk.Buffer, instances, Tilemap::ChunkTiles);
+		chunk.InstanceCount = (uint32_t)instances.size();
+		chunk.Dirty = false;
+	}
 
-		s_Data->LineVertexIndex = vertexIndex;
+	void Renderer::SetAtlasMaxTextureSize(uint32_t size)
+	{
+		s_Data->Atlas.SetMaxTextureSize(size);
 	}
 
-	void Renderer::DrawRect(const glm::vec3& position, const glm::vec2& scale, const glm::vec4& color, int entityId)
+	void Renderer::SetThreaded(bool threaded)
 	{
-		const glm::vec3& p0 = glm::vec3(position.x - scale.x * 0.5f, position.y - scale.y * 0.5f, position.z);
-		const glm::vec3& p1 = glm::vec3(position.x + scale.x * 0.5f, position.y - scale.y * 0.5f, position.z);
-		const glm::vec3& p2 = glm::vec3(position.x + scale.x * 0.5f, position.y + scale.y * 0.5f, position.z);
-		const glm::vec3& p3 = glm::vec3(position.x - scale.x * 0.5f, position.y + scale.y * 0.5f, position.z);
+		Flush();
+		s_Data->Threaded = threaded;
+	}
 
-		DrawLine(p0, p1, color, entityId);
-		DrawLine(p1, p2, color, entityId);
-		DrawLine(p2, p3, color, entityId);
-		DrawLine(p3, p0, color, entityId);
+	bool Renderer::IsThreaded()
+	{
+		return s_Data->Threaded;
 	}
 
-	void Renderer::DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityId)
+	void Renderer::SetWriteThreads(uint32_t count)
 	{
-		glm::vec3 lineVertices[4];
-		for (size_t i = 0; i < 4; i++)
-			lineVertices[i] = transform * VertexPositions[i];
+		//The packet in flight may still be writing with the old pool
+		Flush();
+		s_Data->Workers = MakeUnique<WorkerPool>(std::max(count, 1u) - 1);
+		s_Stats->WriteThreads = s_Data->Workers->GetThreadCount();
+	}
 
-		DrawLine(lineVertices[0], lineVertices[1], color, entityId);
-		DrawLine(lineVertices[1], lineVertices[2], color, entityId);
-		DrawLine(lineVertices[2], lineVertices[3], color, entityId);
-		DrawLine(lineVertices[3], lineVertices[0], color, entityId);
+	uint32_t Renderer::GetWriteThreads()
+	{
+		return s_Data->Workers->GetThreadCount();
 	}
 
-	void Renderer::SetLineWidth(float width)
+	void Renderer::SetRenderMode(RenderMode mode)
 	{
-		glLineWidth(width);
+		//The packet was sized for the old mode, its quads are drawn with it
+		if (mode != s_Data->Mode && !s_Data->Recording().IsEmpty())
+			End();
+		s_Data->Mode = mode;
 	}
 
-	//-Line Renderer
+	RenderMode Renderer::GetRenderMode()
+	{
+		return s_Data->Mode;
+	}
 
-	void Renderer::Terminate()
+	void Renderer::SetOverdrawView(bool enabled)
 	{
-		glDeleteVertexArrays(1, &s_Data->QuadVertexArray);
-		glDeleteBuffers(1, &s_Data->QuadVertexBuffer);
-		glDeleteBuffers(1, &s_Data->QuadIndexBuffer);
+		s_Data->Overdraw = enabled;
+	}
 
-		for (int i = 0; i < s_Data->MaxLayers; i++)
-		{
-			s_Data->QLayerArray[i].QuadVertexIndex = 0;
-			delete[] s_Data->QLayerArray[i].QuadVertices;
-			s_Data->QLayerArray[i].QuadVertices = nullptr;
-		}
+	bool Renderer::IsOverdrawView()
+	{
+		return s_Data->Overdraw;
+	}
 
-		delete[] s_Data->QLayerArray;
+	//-Quad Renderer
 
+	void Renderer::Terminate()
+	{
+		Flush();
+		TextureLoader::Terminate();
+		DebugRenderer::Terminate();
+		RenderTargetPool::Terminate();
+		s_Data->Thread = nullptr;
+		s_Data->Workers = nullptr;
+		s_Data->Timer = nullptr;
+
+		RendererAPI* api = RendererAPI::Get();
+		api->DeleteVertexArray(s_Data->QuadVertexArray);
+		api->DeleteVertexArray(s_Data->QuadInstanceArray);
+		api->DeleteBuffer(s_Data->QuadIndexBuffer);
+		api->DeleteBuffer(s_Data->FrameUniformBuffer);
+
+		//The atlas pages and textures held by the packets are released before the api goes away
 		delete s_Data;
 		s_Data = nullptr;
 
 		delete s_Stats;
 		s_Stats = nullptr;
+
+		RendererAPI::Destroy();
 	}
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
 #pragma once
+#include "Renderer/RendererAPI.h"
+#include "Renderer/StaticBatch.h"
+#include "Renderer/Tilemap.h"
 
 namespace MoonEngine
 {
@@ -6,43 +9,188 @@ namespace MoonEngine
 	class TextureSheet;
 
 	struct RenderData;
+	struct FramePacket;
 	struct TransformComponent;
 	struct SpriteComponent;
+	struct TilemapComponent;
+
+	enum class RenderMode
+	{
+		//Four pre-transformed vertices per quad
+		Batched,
+		//One instance record per quad, corners are expanded on the gpu
+		Instanced
+	};
+
+	//Why the renderer had to cut a batch or a packet short
+	enum class FlushReason
+	{
+		//Packet ran out of stream space for quads
+		QuadOverflow,
+		//Batch ran out of texture slots
+		TextureSlots,
+		Count
+	};
+
+	//A sprite resolved to a world space quad, built once per frame and replayed by every view that sees it
+	struct SpriteRenderItem
+	{
+		glm::vec3 AxisX;
+		glm::vec3 AxisY;
+		glm::vec3 Position;
+		glm::vec4 Color;
+		//In the texture's own uv space, atlas regions belong to the packet and are applied when the item is drawn
+		glm::vec4 TexRect;
+		glm::vec2 Tiling;
+		int Layer;
+		Shared<Texture> Texture;
+	};
+
+	//Result of Scene::QueryVisibleSprites, the items stay valid until the next query
+	struct SpriteQuery
+	{
+		const std::vector<const SpriteRenderItem*>* Items;
+
+		size_t size() const { return Items->size(); }
+	};
+
+	struct RenderPassStats
+	{
+		static constexpr uint32_t HistorySize = 120;
+
+		std::string Name;
+		//Milliseconds, results arrive a few frames late since queries are never waited on
+		float GpuTime = 0.0f;
+		float GpuTimeHistory[HistorySize] = {};
+	};
 
 	struct RendererStats
 	{
-		uint32_t MaxLayers;
-		uint32_t DrawCalls;
+		uint32_t MaxLayers = 0;
+		uint32_t AtlasPages = 0;
+		//Framebuffer attachments held by the pool, and how often one was created or had to grow since startup
+		uint32_t RenderTargets = 0;
+		uint32_t RenderTargetAllocations = 0;
+		uint32_t RenderTargetReallocations = 0;
+
+		//Counters of the last finished frame
+		uint64_t Frame = 0;
+		uint32_t DrawCalls = 0;
+		uint32_t Quads = 0;
+		uint32_t StaticQuads = 0;
+		//Streamed quads drawn in the depth tested front to back pass
+		uint32_t OpaqueQuads = 0;
+		//Segments drawn by the DebugRenderer
+		uint32_t Lines = 0;
+		uint64_t UploadBytes = 0;
+		uint32_t TextureBinds = 0;
+		uint32_t ShaderBinds = 0;
+		//Milliseconds the render thread and its workers spent writing streamed quads
+		float WriteTime = 0.0f;
+		uint32_t WriteThreads = 0;
+		uint32_t Flushes[(size_t)FlushReason::Count] = {};
+
+		//Passes are named by Renderer::Begin, history is a ring indexed by HistoryOffset
+		std::vector<RenderPassStats> Passes;
+		float DrawCallHistory[RenderPassStats::HistorySize] = {};
+		uint32_t HistoryOffset = 0;
 	};
 
 	class Renderer
 	{
 	public:
 		//Application initializes this you dont need to call this. If you want a custom call, remove the call from Application.cpp
-		static void Init();
+		static void Init(RendererBackend backend = RendererBackend::OpenGL);
 		//Application initializes this you dont need to call this. If you want a custom call, remove the call from Application.cpp
 		static void Terminate();
 
-		static void DrawEntity(const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation, const glm::vec4& color, const Shared<Texture>& texture = 0, int layer = 0, const glm::vec2& tiling = { 1.0f, 1.0f }, int entityId = -1);
-		static void DrawEntity(const TransformComponent& tC, const SpriteComponent& sC, int entityId = -1);
+		static void DrawEntity(const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation, const glm::vec4& color, const Shared<Texture>& texture = 0, int layer = 0, const glm::vec2& tiling = { 1.0f, 1.0f });
+		static void DrawEntity(const TransformComponent& tC, const SpriteComponent& sC);
+
+		static void DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, int layer, const glm::vec2& tiling);
+		static void DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<TextureSheet>& spriteSheet, int layer, const glm::vec2& tiling);
 
-		static void DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, int layer, const glm::vec2& tiling, int entityId);
-		static void DrawEntity(const glm::mat4& transform, const glm::vec4& color, const Shared<TextureSheet>& spriteSheet, int layer, const glm::vec2& tiling, int entityId);
+		//Bulk submission for a view of TransformComponent and SpriteComponent pairs, anything with an entt style each(func) works
+		template<typename View>
+		static void DrawSprites(const View& view)
+		{
+			const TransformComponent* transforms[SpriteBlockSize];
+			const SpriteComponent* sprites[SpriteBlockSize];
+			uint32_t count = 0;
 
-		static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityId = -1);
+			view.each([&](auto, const auto& transform, const auto& sprite)
+			{
+				transforms[count] = &transform;
+				sprites[count] = &sprite;
 
-		static void DrawRect(const glm::vec3& position, const glm::vec2& scale, const glm::vec4& color, int entityId = -1);
-		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityId = -1);
+				if (++count == SpriteBlockSize)
+				{
+					SubmitSprites(transforms, sprites, count);
+					count = 0;
+				}
+			});
 
-		static void Begin(const glm::mat4& viewProjection);
+			if (count > 0)
+				SubmitSprites(transforms, sprites, count);
+		}
+
+		//Replays items extracted earlier in the frame, Scene::QueryVisibleSprites returns the ones inside a camera
+		static void DrawSprites(const SpriteQuery& query);
+		//Resolves up to SpriteBlockSize transform and sprite pairs to world space quads, 2D sprites skip the matrix path entirely
+		static constexpr uint32_t SpriteBlockSize = 64;
+		static void BuildSpriteItems(const TransformComponent* const* transforms, const SpriteComponent* const* sprites, SpriteRenderItem* const* items, uint32_t count);
+
+		//Draws the chunks of the batch overlapping the view, dirty chunks are rebuilt first
+		static void DrawStaticBatch(StaticBatch& batch, const glm::vec2& viewMin, const glm::vec2& viewMax);
+		//Same for the chunks of a tilemap, every chunk is re-meshed when the transform or the tileset settings change
+		static void DrawTilemap(const TransformComponent& transform, TilemapComponent& tilemap, const glm::vec2& viewMin, const glm::vec2& viewMax);
+
+		//Everything until the next Begin is timed and reported under the pass name. Without clear the pass draws over what the target holds
+		static void Begin(const glm::mat4& viewProjection, const char* pass = "Scene", bool clear = true);
+		//Closes the recorded packet and hands it to the render thread, its draws are issued by the next End or Flush.
+		//Packets never outlive their frame, preparing one overlaps the rest of the same frame and not the next one
 		static void End();
-		static void RenderIndexed(int layer = -1);
-		static void RenderLines();
+		//Issues the draws of the packet in flight. Needed before anything reads or changes a target the renderer draws into
+		static void Flush();
+		//Flushes and publishes the counters of the frame to GetStats. Application calls this once per frame
+		static void EndFrame();
+
+		//Textures up to this size in both dimensions are packed into shared atlas pages, 0 turns packing off
+		static void SetAtlasMaxTextureSize(uint32_t size);
+
+		//Runs sorting, batching and vertex writing on the render thread instead of inline
+		static void SetThreaded(bool threaded);
+		static bool IsThreaded();
+
+		//Threads splitting the vertex and instance writing of a packet, the render thread counts as one
+		static void SetWriteThreads(uint32_t count);
+		static uint32_t GetWriteThreads();
+
+		static void SetRenderMode(RenderMode mode);
+		static RenderMode GetRenderMode();
+
+		//Draws every fragment as a faint additive tint, bright areas are shaded many times over
+		static void SetOverdrawView(bool enabled);
+		static bool IsOverdrawView();
 
 		static void SetClearColor(const glm::vec3& color);
 		static const RendererStats& GetStats() { return *s_Stats; }
-		static void SetLineWidth(float width);
 	private:
 		static RendererStats* s_Stats;
+
+		static void SubmitSprites(const TransformComponent* const* transforms, const SpriteComponent* const* sprites, uint32_t count);
+		static void SubmitSpriteItems(const SpriteRenderItem* const* items, uint32_t count);
+		//TexRect is in the texture's own uv space, atlased textures are remapped onto their page
+		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color, const Shared<Texture>& texture, const glm::vec4& texRect, int layer, const glm::vec2& tiling);
+
+		static void AllocateStreams(FramePacket& packet);
+		static void DrawQuads(FramePacket& packet);
+		//Fills the Frame uniform block for the bound target
+		static void SetFrameUniforms(const glm::mat4& viewProjection);
+		static void RebuildStaticChunk(StaticBatch& batch, StaticBatch::StaticChunk& chunk);
+		static void RebuildTilemapChunk(Tilemap& tilemap, Tilemap::TileChunk& chunk);
+
+		friend class DebugRenderer;
+		friend class FrameCapture;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "mpch.h"
+#include "Renderer/RendererAPI.h"
+
+#include "Renderer/NullRendererAPI.h"
+#include "Renderer/OpenGLRendererAPI.h"
+
+namespace MoonEngine
+{
+	Unique<RendererAPI> RendererAPI::s_Instance = nullptr;
+	RendererBackend RendererAPI::s_Backend = RendererBackend::OpenGL;
+
+	void RendererAPI::Create(RendererBackend backend)
+	{
+		s_Backend = backend;
+
+		switch (backend)
+		{
+			case RendererBackend::OpenGL:
+				s_Instance = MakeUnique<OpenGLRendererAPI>();
+				break;
+			case RendererBackend::Null:
+				s_Instance = MakeUnique<NullRendererAPI>();
+				break;
+		}
+
+		s_Instance->Init();
+	}
+
+	void RendererAPI::Destroy()
+	{
+		s_Instance = nullptr;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+namespace MoonEngine
+{
+	class Texture;
+
+	enum class RendererBackend
+	{
+		OpenGL,
+		//Runs all cpu side work of the renderer and records the commands it would issue, needs no gpu or window
+		Null
+	};
+
+	enum class AttributeType
+	{
+		Float,
+		Int,
+		UByteNormalized
+	};
+
+	struct VertexAttribute
+	{
+		AttributeType Type;
+		uint32_t Components;
+		uint32_t Offset;
+	};
+
+	struct VertexLayout
+	{
+		uint32_t Stride;
+		//Attributes advance once per instance instead of once per vertex
+		bool PerInstance;
+		std::vector<VertexAttribute> Attributes;
+	};
+
+	enum class DepthMode
+	{
+		Off,
+		//Tests and writes, for the opaque pass
+		TestWrite,
+		//Tests against what the opaque pass wrote without writing itself
+		Test
+	};
+
+	enum class BlendMode
+	{
+		Alpha,
+		//Sums every fragment, used to visualize overdraw
+		Additive
+	};
+
+	struct RenderTarget
+	{
+		int32_t Framebuffer = 0;
+		int32_t Viewport[4] = {};
+		//Without a depth attachment the renderer draws opaque quads back to front like the rest
+		bool Depth = true;
+	};
+
+	//Everything the renderer asks of the graphics api. Texture, Shader and Framebuffer skip their gl calls under the null backend
+	class RendererAPI
+	{
+	public:
+		virtual ~RendererAPI() = default;
+
+		static void Create(RendererBackend backend);
+		static void Destroy();
+		static RendererAPI* Get() { return s_Instance.get(); }
+		static RendererBackend GetBackend() { return s_Backend; }
+		static bool IsNull() { return s_Backend == RendererBackend::Null; }
+
+		virtual void Init() = 0;
+
+		virtual void SetClearColor(const glm::vec3& color) = 0;
+		virtual void Clear() = 0;
+		virtual RenderTarget GetTarget() = 0;
+		virtual void SetTarget(const RenderTarget& target) = 0;
+		virtual void SetDepthMode(DepthMode mode) = 0;
+		virtual void SetBlendMode(BlendMode mode) = 0;
+
+		virtual uint32_t CreateBuffer(uint32_t size, const void* data = nullptr) = 0;
+		virtual void UpdateBuffer(uint32_t buffer, const void* data, uint32_t size) = 0;
+		virtual void DeleteBuffer(uint32_t buffer) = 0;
+		virtual void BindUniformBuffer(uint32_t binding, uint32_t buffer) = 0;
+		virtual uint32_t CreateVertexArray(const VertexLayout& layout, uint32_t vertexBuffer, uint32_t indexBuffer = 0) = 0;
+		virtual void DeleteVertexArray(uint32_t vertexArray) = 0;
+
+		virtual void DrawIndexed(uint32_t vertexArray, uint32_t indexCount, uint32_t baseVertex) = 0;
+		virtual void DrawIndexedInstanced(uint32_t vertexArray, uint32_t indexCount, uint32_t instanceCount, uint32_t baseInstance) = 0;
+
+		virtual void ClearTexture(const Texture& texture) = 0;
+		virtual void CopyTexture(const Texture& source, uint32_t sourceX, uint32_t sourceY, const Texture& destination, uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+		//Fills a whole mip level from tightly packed rgba8 pixels at offset inside pixelBuffer
+		virtual void UploadTexture(const Texture& texture, uint32_t level, uint32_t pixelBuffer, uint32_t offset) = 0;
+	private:
+		static Unique<RendererAPI> s_Instance;
+		static RendererBackend s_Backend;
+	};
+}
\ No newline at end of file
@@ -2,14 +2,54 @@
 #include "Renderer/Shader.h"
 
 #include "Core/Debug.h"
+#include "Renderer/RendererAPI.h"
 
 #include <glad/glad.h>
 
+#include <chrono>
+
 namespace MoonEngine
 {
+	//Programs are cached per driver, a driver update or a changed source simply misses
+	static const char* CacheDirectory = "Cache/Shaders";
+	static constexpr uint32_t CacheMagic = 0x4342534d;
+	static constexpr uint64_t FnvOffset = 14695981039346656037ull;
+
+	struct CacheHeader
+	{
+		uint32_t Magic;
+		uint32_t Format;
+		uint64_t Key;
+	};
+
+	ShaderCacheStats Shader::s_CacheStats;
+
+	static uint64_t HashText(uint64_t hash, const std::string& text)
+	{
+		for (char c : text)
+			hash = (hash ^ (uint8_t)c) * 1099511628211ull;
+		return hash;
+	}
+
+	static const std::string& GetDriverString()
+	{
+		static const std::string driver = std::string((const char*)glGetString(GL_VENDOR)) + (const char*)glGetString(GL_RENDERER) + (const char*)glGetString(GL_VERSION);
+		return driver;
+	}
+
+	static std::filesystem::path GetCachePath(uint64_t key)
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+		return std::filesystem::path(CacheDirectory) / name;
+	}
+
 	Shader::Shader(const std::string& filepath)
 		:m_ShaderBuffer(0)
 	{
+		if (RendererAPI::IsNull())
+			return;
+
 		uint32_t IsFragment = 0;
 
 		std::ifstream stream(filepath);
@@ -39,61 +79,310 @@ namespace MoonEngine
 
 	uint32_t Shader::CompileShader(unsigned int type, const std::string& source)
 	{
+		//Status is only read in Finish, asking now would wait for the compile
 		uint32_t id = glCreateShader(type);
 		const char* src = source.c_str();
 		glShaderSource(id, 1, &src, nullptr);
 		glCompileShader(id);
+		return id;
+	}
+
+	void Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		m_CacheKey = HashText(HashText(HashText(FnvOffset, GetDriverString()), vertexShader), fragmentShader);
+		m_ShaderBuffer = glCreateProgram();
 
-		int success;
-		glGetShaderiv(id, GL_COMPILE_STATUS, &success);
-		if (!success)
+		if (LoadBinary())
+		{
+			s_CacheStats.Loaded++;
+			Reflect();
+		}
+		else
+		{
+			//A rejected binary leaves the program unusable
+			glDeleteProgram(m_ShaderBuffer);
+			m_ShaderBuffer = glCreateProgram();
+			glProgramParameteri(m_ShaderBuffer, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+			m_Stages[0] = CompileShader(GL_VERTEX_SHADER, vertexShader);
+			m_Stages[1] = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+
+			glAttachShader(m_ShaderBuffer, m_Stages[0]);
+			glAttachShader(m_ShaderBuffer, m_Stages[1]);
+			glLinkProgram(m_ShaderBuffer);
+
+			m_Pending = true;
+			s_CacheStats.Compiled++;
+		}
+
+		s_CacheStats.Time += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void Shader::Finish()
+	{
+		if (!m_Pending)
+			return;
+
+		auto start = std::chrono::steady_clock::now();
+		m_Pending = false;
+
+		int32_t linked = 0;
+		glGetProgramiv(m_ShaderBuffer, GL_LINK_STATUS, &linked);
+
+		if (!linked)
 		{
 			char infoLog[512];
-			glGetShaderInfoLog(id, 512, NULL, infoLog);
-			ME_SYS_ERR("{0} Shader Compile Error: {1}", type == GL_VERTEX_SHADER ? "Vertex " : "Fragment ", infoLog);
-			glDeleteShader(id);
-			return 0;
+			for (uint32_t stage : m_Stages)
+			{
+				int32_t compiled = 0;
+				glGetShaderiv(stage, GL_COMPILE_STATUS, &compiled);
+				if (compiled)
+					continue;
+
+				int32_t type = 0;
+				glGetShaderiv(stage, GL_SHADER_TYPE, &type);
+				glGetShaderInfoLog(stage, sizeof(infoLog), NULL, infoLog);
+				ME_SYS_ERR("{0} Shader Compile Error: {1}", type == GL_VERTEX_SHADER ? "Vertex " : "Fragment ", infoLog);
+			}
+
+			glGetProgramInfoLog(m_ShaderBuffer, sizeof(infoLog), NULL, infoLog);
+			ME_SYS_ERR("Shader Link Error: {0}", infoLog);
 		}
-		return id;
+
+		for (uint32_t& stage : m_Stages)
+		{
+			glDetachShader(m_ShaderBuffer, stage);
+			glDeleteShader(stage);
+			stage = 0;
+		}
+
+		if (linked)
+		{
+			SaveBinary();
+			Reflect();
+		}
+
+		s_CacheStats.Time += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 	}
 
-	void Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader)
+	bool Shader::LoadBinary()
 	{
-		m_ShaderBuffer = glCreateProgram();
-		uint32_t vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-		uint32_t fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+		std::ifstream stream(GetCachePath(m_CacheKey), std::ios::binary);
+		if (!stream)
+			return false;
+
+		CacheHeader header;
+		if (!stream.read((char*)&header, sizeof(header)) || header.Magic != CacheMagic || header.Key != m_CacheKey)
+			return false;
+
+		std::vector<char> binary((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		glProgramBinary(m_ShaderBuffer, header.Format, binary.data(), (GLsizei)binary.size());
+
+		//Drivers refuse binaries of another build even when the version string matches
+		int32_t linked = 0;
+		glGetProgramiv(m_ShaderBuffer, GL_LINK_STATUS, &linked);
+		return linked;
+	}
+
+	void Shader::SaveBinary()
+	{
+		int32_t length = 0;
+		glGetProgramiv(m_ShaderBuffer, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		CacheHeader header = { CacheMagic, 0, m_CacheKey };
+		std::vector<char> binary(length);
+		glGetProgramBinary(m_ShaderBuffer, length, nullptr, &header.Format, binary.data());
 
-		glAttachShader(m_ShaderBuffer, vs);
-		glAttachShader(m_ShaderBuffer, fs);
-		glLinkProgram(m_ShaderBuffer);
-		glValidateProgram(m_ShaderBuffer);
+		std::error_code error;
+		std::filesystem::create_directories(CacheDirectory, error);
 
-		glDeleteShader(vs);
-		glDeleteShader(fs);
+		std::ofstream stream(GetCachePath(m_CacheKey), std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			ME_SYS_WAR("Shader cache could not be written!");
+			return;
+		}
+
+		stream.write((const char*)&header, sizeof(header));
+		stream.write(binary.data(), binary.size());
+	}
+
+	template<typename T>
+	static const T* FindByName(const std::vector<T>& table, uint32_t name)
+	{
+		auto it = std::lower_bound(table.begin(), table.end(), name, [](const T& entry, uint32_t value) { return entry.Name < value; });
+		return it != table.end() && it->Name == name ? &*it : nullptr;
 	}
 
-	void Shader::Bind() const
+	template<typename T>
+	static void SortByName(std::vector<T>& table)
 	{
+		std::sort(table.begin(), table.end(), [](const T& a, const T& b) { return a.Name < b.Name; });
+		for (size_t i = 1; i < table.size(); i++)
+			ME_ASSERT((table[i - 1].Name != table[i].Name), "Shader names collide in their hash!");
+	}
+
+	static uint32_t HashResourceName(const char* name, int32_t length)
+	{
+		std::string_view view(name, length);
+		if (view.size() > 3 && view.substr(view.size() - 3) == "[0]")
+			view.remove_suffix(3);
+
+		return Shader::Hash(view);
+	}
+
+	void Shader::Reflect()
+	{
+		char name[256];
+		int32_t count = 0;
+
+		//Uniforms inside blocks report location -1 and are reached through their block instead
+		glGetProgramInterfaceiv(m_ShaderBuffer, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+		for (int32_t i = 0; i < count; i++)
+		{
+			const GLenum properties[4] = { GL_NAME_LENGTH, GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE };
+			int32_t values[4];
+			glGetProgramResourceiv(m_ShaderBuffer, GL_UNIFORM, i, 4, properties, 4, nullptr, values);
+			if (values[1] < 0)
+				continue;
+
+			int32_t length = 0;
+			glGetProgramResourceName(m_ShaderBuffer, GL_UNIFORM, i, sizeof(name), &length, name);
+			m_Uniforms.push_back({ HashResourceName(name, length), values[1], (uint32_t)values[2], values[3] });
+		}
+
+		glGetProgramInterfaceiv(m_ShaderBuffer, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &count);
+		for (int32_t i = 0; i < count; i++)
+		{
+			const GLenum properties[2] = { GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE };
+			int32_t values[2];
+			glGetProgramResourceiv(m_ShaderBuffer, GL_UNIFORM_BLOCK, i, 2, properties, 2, nullptr, values);
+
+			int32_t length = 0;
+			glGetProgramResourceName(m_ShaderBuffer, GL_UNIFORM_BLOCK, i, sizeof(name), &length, name);
+			m_Blocks.push_back({ HashResourceName(name, length), (uint32_t)values[0], (uint32_t)values[1] });
+		}
+
+		glGetProgramInterfaceiv(m_ShaderBuffer, GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &count);
+		for (int32_t i = 0; i < count; i++)
+		{
+			const GLenum properties[2] = { GL_LOCATION, GL_TYPE };
+			int32_t values[2];
+			glGetProgramResourceiv(m_ShaderBuffer, GL_PROGRAM_INPUT, i, 2, properties, 2, nullptr, values);
+
+			//Built in inputs like gl_VertexID have no location
+			if (values[0] < 0)
+				continue;
+
+			int32_t length = 0;
+			glGetProgramResourceName(m_ShaderBuffer, GL_PROGRAM_INPUT, i, sizeof(name), &length, name);
+			m_Attributes.push_back({ HashResourceName(name, length), values[0], (uint32_t)values[1] });
+		}
+
+		SortByName(m_Uniforms);
+		SortByName(m_Blocks);
+		SortByName(m_Attributes);
+
+		//Sampler arrays never change, they get consecutive texture units here instead of on every bind
+		for (const ShaderUniform& uniform : m_Uniforms)
+		{
+			if (uniform.Type != GL_SAMPLER_2D || uniform.Count <= 1)
+				continue;
+
+			std::vector<int32_t> units(uniform.Count);
+			for (int32_t i = 0; i < uniform.Count; i++)
+				units[i] = i;
+
+			glProgramUniform1iv(m_ShaderBuffer, uniform.Location, uniform.Count, units.data());
+		}
+	}
+
+	int32_t Shader::GetUniformLocation(uint32_t name) const
+	{
+		const ShaderUniform* uniform = FindByName(m_Uniforms, name);
+		return uniform ? uniform->Location : -1;
+	}
+
+	int32_t Shader::GetAttributeLocation(uint32_t name) const
+	{
+		const ShaderAttribute* attribute = FindByName(m_Attributes, name);
+		return attribute ? attribute->Location : -1;
+	}
+
+	const ShaderBlock* Shader::GetBlock(uint32_t name) const
+	{
+		return FindByName(m_Blocks, name);
+	}
+
+	void Shader::Bind()
+	{
+		if (RendererAPI::IsNull())
+			return;
+
+		Finish();
 		glUseProgram(m_ShaderBuffer);
 	}
 
 	void Shader::Unbind() const
 	{
+		if (RendererAPI::IsNull())
+			return;
+
 		glUseProgram(0);
 	}
 
-	void Shader::SetMat4(const std::string& key, const glm::mat4& val)
+	void Shader::SetMat4(uint32_t name, const glm::mat4& val)
+	{
+		Finish();
+		int32_t location = GetUniformLocation(name);
+		if (location >= 0)
+			glProgramUniformMatrix4fv(m_ShaderBuffer, location, 1, GL_FALSE, &val[0][0]);
+	}
+
+	void Shader::SetInt(uint32_t name, int32_t val)
+	{
+		Finish();
+		int32_t location = GetUniformLocation(name);
+		if (location >= 0)
+			glProgramUniform1i(m_ShaderBuffer, location, val);
+	}
+
+	void Shader::SetFloat(uint32_t name, float val)
 	{
-		glUniformMatrix4fv(glGetUniformLocation(m_ShaderBuffer, key.c_str()), 1, GL_FALSE, &val[0][0]);
+		Finish();
+		int32_t location = GetUniformLocation(name);
+		if (location >= 0)
+			glProgramUniform1f(m_ShaderBuffer, location, val);
 	}
 
-	void Shader::SetIntArray(const std::string& key, uint32_t size, const int32_t* val)
+	void Shader::SetFloat2(uint32_t name, const glm::vec2& val)
 	{
-		glUniform1iv(glGetUniformLocation(m_ShaderBuffer, key.c_str()), size, val);
+		Finish();
+		int32_t location = GetUniformLocation(name);
+		if (location >= 0)
+			glProgramUniform2f(m_ShaderBuffer, location, val.x, val.y);
+	}
+
+	void Shader::SetIntArray(uint32_t name, uint32_t size, const int32_t* val)
+	{
+		Finish();
+		int32_t location = GetUniformLocation(name);
+		if (location >= 0)
+			glProgramUniform1iv(m_ShaderBuffer, location, size, val);
 	}
 
 	Shader::~Shader()
 	{
+		if (RendererAPI::IsNull())
+			return;
+
+		for (uint32_t stage : m_Stages)
+			glDeleteShader(stage);
+
 		glDeleteProgram(m_ShaderBuffer);
 	}
 }
\ No newline at end of file
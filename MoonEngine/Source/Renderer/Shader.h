@@ -1,23 +1,103 @@
 #pragma once
+#include <string_view>
 
 namespace MoonEngine
 {
+	struct ShaderUniform
+	{
+		uint32_t Name;
+		int32_t Location;
+		uint32_t Type;
+		//Elements of an array, 1 otherwise
+		int32_t Count;
+	};
+
+	struct ShaderBlock
+	{
+		uint32_t Name;
+		uint32_t Binding;
+		uint32_t Size;
+	};
+
+	struct ShaderAttribute
+	{
+		uint32_t Name;
+		int32_t Location;
+		uint32_t Type;
+	};
+
+	struct ShaderCacheStats
+	{
+		//Programs loaded from the binary cache and programs built from source
+		uint32_t Loaded = 0;
+		uint32_t Compiled = 0;
+		//Milliseconds the cpu spent creating and finishing programs
+		float Time = 0.0f;
+	};
+
+	//Active uniforms, uniform blocks and attributes are reflected once at link time into tables sorted by name hash
+	//Setters take the hash, so callers can precompute it with Shader::Hash("uName") instead of passing strings around
+	//Linked programs are cached on disk. Programs built from source link in the background and are finished on first use
 	class Shader
 	{
 	public:
 		Shader(const std::string& filepath);
 		~Shader();
 
-		void Bind() const;
+		void Bind();
 		void Unbind() const;
 
-		void SetMat4(const std::string& key, const glm::mat4& val);
-		void SetIntArray(const std::string& key, uint32_t size, const int32_t* val);
+		void SetMat4(uint32_t name, const glm::mat4& val);
+		void SetInt(uint32_t name, int32_t val);
+		void SetFloat(uint32_t name, float val);
+		void SetFloat2(uint32_t name, const glm::vec2& val);
+		void SetIntArray(uint32_t name, uint32_t size, const int32_t* val);
+
+		void SetMat4(const std::string& key, const glm::mat4& val) { SetMat4(Hash(key), val); }
+		void SetInt(const std::string& key, int32_t val) { SetInt(Hash(key), val); }
+		void SetFloat(const std::string& key, float val) { SetFloat(Hash(key), val); }
+		void SetFloat2(const std::string& key, const glm::vec2& val) { SetFloat2(Hash(key), val); }
+		void SetIntArray(const std::string& key, uint32_t size, const int32_t* val) { SetIntArray(Hash(key), size, val); }
+
+		//Waits for a program still linking in the background. Bind and the setters call it
+		void Finish();
+
+		//-1 when the shader has no such uniform or attribute, the tables are filled once the program is finished
+		int32_t GetUniformLocation(uint32_t name) const;
+		int32_t GetAttributeLocation(uint32_t name) const;
+		const ShaderBlock* GetBlock(uint32_t name) const;
+
+		const std::vector<ShaderUniform>& GetUniforms() const { return m_Uniforms; }
+		const std::vector<ShaderBlock>& GetBlocks() const { return m_Blocks; }
+		const std::vector<ShaderAttribute>& GetAttributes() const { return m_Attributes; }
 
 		uint32_t GetShaderProgram() const { return m_ShaderBuffer; }
+		static const ShaderCacheStats& GetCacheStats() { return s_CacheStats; }
+
+		//FNV-1a of the name, array uniforms are hashed without their [0] suffix
+		static constexpr uint32_t Hash(std::string_view name)
+		{
+			uint32_t hash = 2166136261u;
+			for (char c : name)
+				hash = (hash ^ (uint8_t)c) * 16777619u;
+			return hash;
+		}
 	private:
 		uint32_t m_ShaderBuffer = 0;
+		uint64_t m_CacheKey = 0;
+		uint32_t m_Stages[2] = {};
+		bool m_Pending = false;
+
+		std::vector<ShaderUniform> m_Uniforms;
+		std::vector<ShaderBlock> m_Blocks;
+		std::vector<ShaderAttribute> m_Attributes;
+
 		uint32_t CompileShader(unsigned int type, const std::string& source);
 		void CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
+		void Reflect();
+		bool LoadBinary();
+		void SaveBinary();
+
+		static ShaderCacheStats s_CacheStats;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "mpch.h"
+#include "Renderer/SpriteAnimation.h"
+
+#include "Renderer/Texture.h"
+#include "Renderer/TextureLoader.h"
+
+namespace MoonEngine
+{
+	struct AnimationKey
+	{
+		const Texture* Source;
+		glm::vec2 CellSize;
+		glm::vec2 FirstCell;
+		uint32_t FrameCount;
+		float FramesPerSecond;
+		AnimationLoopMode LoopMode;
+
+		bool operator==(const AnimationKey& other) const
+		{
+			return Source == other.Source && CellSize == other.CellSize && FirstCell == other.FirstCell && FrameCount == other.FrameCount
+				&& FramesPerSecond == other.FramesPerSecond && LoopMode == other.LoopMode;
+		}
+	};
+
+	struct AnimationKeyHash
+	{
+		size_t operator()(const AnimationKey& key) const
+		{
+			size_t hash = std::hash<const void*>()(key.Source);
+			for (float value : { key.CellSize.x, key.CellSize.y, key.FirstCell.x, key.FirstCell.y, key.FramesPerSecond, (float)key.FrameCount, (float)key.LoopMode })
+				hash = hash * 31 + std::hash<float>()(value);
+			return hash;
+		}
+	};
+
+	static std::unordered_map<AnimationKey, Weak<SpriteAnimation>, AnimationKeyHash> s_Animations;
+
+	SpriteAnimation::SpriteAnimation(const Shared<Texture>& texture, const glm::vec2& cellSize, const glm::vec2& firstCell, uint32_t frameCount, float framesPerSecond, AnimationLoopMode loopMode)
+		:m_Texture(texture), m_CellSize(cellSize), m_FirstCell(firstCell), m_LoopMode(loopMode)
+	{
+		m_FrameDuration = framesPerSecond > 0.0f ? 1.0f / framesPerSecond : 0.0f;
+		m_Frames.resize(std::max(frameCount, 1u));
+		CalculateFrames();
+	}
+
+	Shared<SpriteAnimation> SpriteAnimation::Get(const Shared<Texture>& texture, const glm::vec2& cellSize, const glm::vec2& firstCell, uint32_t frameCount, float framesPerSecond, AnimationLoopMode loopMode)
+	{
+		AnimationKey key = { texture.get(), cellSize, firstCell, frameCount, framesPerSecond, loopMode };
+		Weak<SpriteAnimation>& entry = s_Animations[key];
+		if (Shared<SpriteAnimation> animation = entry.lock())
+			return animation;
+
+		//A released clip leaves its slot behind, sweep them while a new one is built anyway
+		for (auto it = s_Animations.begin(); it != s_Animations.end();)
+			it = it->second.expired() && &it->second != &entry ? s_Animations.erase(it) : std::next(it);
+
+		Shared<SpriteAnimation> animation = MakeShared<SpriteAnimation>(texture, cellSize, firstCell, frameCount, framesPerSecond, loopMode);
+		entry = animation;
+
+		TextureLoader::OnLoaded(texture, [clip = Weak<SpriteAnimation>(animation)]
+		{
+			if (Shared<SpriteAnimation> owner = clip.lock())
+				owner->CalculateFrames();
+		});
+
+		return animation;
+	}
+
+	float SpriteAnimation::WrapTime(float time) const
+	{
+		uint32_t frameCount = GetFrameCount();
+		float length = m_FrameDuration * frameCount;
+		if (length <= 0.0f)
+			return 0.0f;
+
+		switch (m_LoopMode)
+		{
+			case AnimationLoopMode::Once:
+				return std::min(time, length);
+			case AnimationLoopMode::Loop:
+				return std::fmod(time, length);
+			case AnimationLoopMode::PingPong:
+				//Both ends are shown once per period
+				return std::fmod(time, m_FrameDuration * std::max(frameCount * 2 - 2, 1u));
+		}
+
+		return time;
+	}
+
+	uint32_t SpriteAnimation::GetFrameAt(float time) const
+	{
+		if (m_FrameDuration <= 0.0f)
+			return 0;
+
+		uint32_t frameCount = GetFrameCount();
+		uint32_t frame = (uint32_t)(time / m_FrameDuration);
+
+		if (m_LoopMode == AnimationLoopMode::PingPong && frame >= frameCount)
+			frame = frameCount * 2 - 2 - frame;
+
+		return std::min(frame, frameCount - 1);
+	}
+
+	void SpriteAnimation::CalculateFrames()
+	{
+		float width = (float)m_Texture->GetWidth();
+		float height = (float)m_Texture->GetHeight();
+
+		//Cells run left to right and continue on the row below, images are flipped so lower rows have smaller y
+		uint32_t columns = std::max((uint32_t)(width / std::max(m_CellSize.x, 1.0f)), 1u);
+		glm::vec2 cell = m_FirstCell;
+
+		for (glm::vec4& frame : m_Frames)
+		{
+			frame = { cell.x * m_CellSize.x / width, cell.y * m_CellSize.y / height, (cell.x + 1.0f) * m_CellSize.x / width, (cell.y + 1.0f) * m_CellSize.y / height };
+
+			cell.x += 1.0f;
+			if (cell.x >= columns)
+			{
+				cell.x = 0.0f;
+				cell.y -= 1.0f;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace MoonEngine
+{
+	class Texture;
+
+	enum class AnimationLoopMode
+	{
+		Once,
+		Loop,
+		PingPong
+	};
+
+	//Clip of sheet cells shared by every animator that plays the same cells of the same texture
+	//Frame rects are computed once, or once more when a texture that was still loading becomes resident
+	class SpriteAnimation
+	{
+	public:
+		SpriteAnimation(const Shared<Texture>& texture, const glm::vec2& cellSize, const glm::vec2& firstCell, uint32_t frameCount, float framesPerSecond, AnimationLoopMode loopMode);
+
+		//Equal requests return the same clip while anyone still holds it
+		static Shared<SpriteAnimation> Get(const Shared<Texture>& texture, const glm::vec2& cellSize, const glm::vec2& firstCell, uint32_t frameCount, float framesPerSecond, AnimationLoopMode loopMode);
+
+		//Keeps playback time inside one period of the clip, a finished Once clip stays at its end
+		float WrapTime(float time) const;
+		uint32_t GetFrameAt(float time) const;
+
+		//Uv rect of the frame, min in xy and max in zw
+		const glm::vec4& GetFrame(uint32_t frame) const { return m_Frames[frame]; }
+		uint32_t GetFrameCount() const { return (uint32_t)m_Frames.size(); }
+		float GetFrameDuration() const { return m_FrameDuration; }
+		AnimationLoopMode GetLoopMode() const { return m_LoopMode; }
+		const Shared<Texture>& GetTexture() const { return m_Texture; }
+	private:
+		Shared<Texture> m_Texture;
+		glm::vec2 m_CellSize;
+		glm::vec2 m_FirstCell;
+		float m_FrameDuration;
+		AnimationLoopMode m_LoopMode;
+
+		//Sized once in the constructor, recalculating never moves it
+		std::vector<glm::vec4> m_Frames;
+
+		void CalculateFrames();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "mpch.h"
+#include "Renderer/StaticBatch.h"
+
+#include "Engine/Components.h"
+
+#include "Renderer/RendererAPI.h"
+
+namespace MoonEngine
+{
+	void StaticBatch::Insert(uint32_t key, const TransformComponent& transform, const SpriteComponent& sprite)
+	{
+		const Shared<TextureSheet>& spriteSheet = sprite.GetTextureSheet();
+		const Shared<Texture>& texture = spriteSheet ? spriteSheet->GetTexture() : sprite.GetTexture();
+		bool tiled = sprite.Tiling != glm::vec2(1.0f);
+
+		auto it = m_Sprites.find(key);
+		if (it == m_Sprites.end())
+		{
+			it = m_Sprites.emplace(key, StaticSprite()).first;
+			it->second.Chunk = UINT32_MAX;
+		}
+
+		StaticSprite& staticSprite = it->second;
+		staticSprite.Position = transform.Position;
+		staticSprite.Scale = transform.Scale;
+		staticSprite.Rotation = transform.Rotation;
+		staticSprite.Color = sprite.Color;
+		staticSprite.Tiling = sprite.Tiling;
+		staticSprite.Sheet = spriteSheet;
+
+		//Sprites that stay in their group are rebuilt in place, the rest move to a chunk of their new group
+		if (staticSprite.Chunk != UINT32_MAX)
+		{
+			StaticChunk& chunk = m_Chunks[staticSprite.Chunk];
+			if (chunk.Layer == sprite.Layer && chunk.SourceTexture == texture && chunk.Tiled == tiled)
+			{
+				chunk.Dirty = true;
+				return;
+			}
+
+			Unlink(staticSprite);
+		}
+
+		uint32_t chunkIndex = FindChunk(sprite.Layer, texture, tiled);
+		StaticChunk& chunk = m_Chunks[chunkIndex];
+		staticSprite.Chunk = chunkIndex;
+		staticSprite.Index = (uint32_t)chunk.Keys.size();
+		chunk.Keys.push_back(key);
+		chunk.Dirty = true;
+	}
+
+	void StaticBatch::Remove(uint32_t key)
+	{
+		auto it = m_Sprites.find(key);
+		if (it == m_Sprites.end())
+			return;
+
+		Unlink(it->second);
+		m_Sprites.erase(it);
+	}
+
+	void StaticBatch::Clear()
+	{
+		for (StaticChunk& chunk : m_Chunks)
+			chunk.Buffer.Release();
+
+		m_Chunks.clear();
+		m_Sprites.clear();
+	}
+
+	uint32_t StaticBatch::FindChunk(int layer, const Shared<Texture>& texture, bool tiled)
+	{
+		//Emptied chunks are reused by any group, their gpu buffers keep their size
+		uint32_t emptyChunk = UINT32_MAX;
+		for (uint32_t i = 0; i < (uint32_t)m_Chunks.size(); i++)
+		{
+			StaticChunk& chunk = m_Chunks[i];
+			if (chunk.Keys.empty())
+			{
+				if (emptyChunk == UINT32_MAX)
+					emptyChunk = i;
+				continue;
+			}
+
+			if (chunk.Layer == layer && chunk.SourceTexture == texture && chunk.Tiled == tiled && chunk.Keys.size() < ChunkCapacity)
+				return i;
+		}
+
+		if (emptyChunk == UINT32_MAX)
+		{
+			emptyChunk = (uint32_t)m_Chunks.size();
+			m_Chunks.emplace_back();
+		}
+
+		StaticChunk& chunk = m_Chunks[emptyChunk];
+		chunk.Layer = layer;
+		chunk.SourceTexture = texture;
+		chunk.Tiled = tiled;
+		chunk.Dirty = true;
+		return emptyChunk;
+	}
+
+	void StaticBatch::Unlink(StaticSprite& sprite)
+	{
+		StaticChunk& chunk = m_Chunks[sprite.Chunk];
+
+		uint32_t movedKey = chunk.Keys.back();
+		chunk.Keys[sprite.Index] = movedKey;
+		m_Sprites[movedKey].Index = sprite.Index;
+		chunk.Keys.pop_back();
+		chunk.Dirty = true;
+
+		if (chunk.Keys.empty())
+		{
+			chunk.SourceTexture = nullptr;
+			chunk.DrawTexture = nullptr;
+			chunk.WaitingTexture = false;
+		}
+
+		sprite.Chunk = UINT32_MAX;
+	}
+
+	StaticBatch::~StaticBatch()
+	{
+		Clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include "Renderer/ChunkBuffer.h"
+
+namespace MoonEngine
+{
+	class Texture;
+	class TextureSheet;
+
+	struct TransformComponent;
+	struct SpriteComponent;
+
+	//Sprites that rarely change, baked into gpu chunks grouped by layer and texture
+	//Changing a sprite only marks its chunk dirty, Renderer::DrawStaticBatch rebuilds dirty chunks before drawing them
+	class StaticBatch
+	{
+	public:
+		StaticBatch() = default;
+		StaticBatch(const StaticBatch&) = delete;
+		StaticBatch& operator=(const StaticBatch&) = delete;
+		~StaticBatch();
+
+		//Adds the sprite or updates it, key identifies the sprite inside the batch
+		void Insert(uint32_t key, const TransformComponent& transform, const SpriteComponent& sprite);
+		void Remove(uint32_t key);
+		void Clear();
+		bool Contains(uint32_t key) const { return m_Sprites.find(key) != m_Sprites.end(); }
+
+		uint32_t GetSpriteCount() const { return (uint32_t)m_Sprites.size(); }
+		uint32_t GetChunkCount() const { return (uint32_t)m_Chunks.size(); }
+	private:
+		static constexpr uint32_t ChunkCapacity = 1024;
+
+		struct StaticSprite
+		{
+			glm::vec3 Position;
+			glm::vec3 Scale;
+			glm::vec3 Rotation;
+			glm::vec4 Color;
+			glm::vec2 Tiling;
+			//Read when the chunk is rebuilt, the cell uvs are only final once the texture is loaded
+			Shared<TextureSheet> Sheet;
+
+			uint32_t Chunk;
+			uint32_t Index;
+		};
+
+		struct StaticChunk
+		{
+			int Layer = 0;
+			Shared<Texture> SourceTexture;
+			bool Tiled = false;
+
+			std::vector<uint32_t> Keys;
+			bool Dirty = true;
+			//Built against the white placeholder, rebuilt once the texture is loaded
+			bool WaitingTexture = false;
+
+			//Filled when the chunk is rebuilt
+			glm::vec2 Min = glm::vec2(0.0f);
+			glm::vec2 Max = glm::vec2(0.0f);
+			Shared<Texture> DrawTexture;
+			//Solid texture and colors, drawn in the depth tested pass
+			bool Opaque = false;
+			uint32_t InstanceCount = 0;
+			ChunkBuffer Buffer;
+		};
+
+		std::unordered_map<uint32_t, StaticSprite> m_Sprites;
+		std::vector<StaticChunk> m_Chunks;
+
+		uint32_t FindChunk(int layer, const Shared<Texture>& texture, bool tiled);
+		void Unlink(StaticSprite& sprite);
+
+		friend class Renderer;
+	};
+}
\ No newline at end of file
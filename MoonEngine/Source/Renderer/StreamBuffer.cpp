@@ -0,0 +1,123 @@
+#include "mpch.h"
+#include "Renderer/StreamBuffer.h"
+
+#include "Core/Debug.h"
+#include "Renderer/RendererAPI.h"
+
+#include <glad/glad.h>
+
+namespace MoonEngine
+{
+	StreamBuffer::StreamBuffer(uint32_t regionSize, uint32_t regionCount)
+		:m_RegionSize(regionSize), m_RegionCount(regionCount)
+	{
+		ME_ASSERT((m_RegionCount <= 32), "Stream buffer supports up to 32 regions!");
+		m_Fences.resize(m_RegionCount, nullptr);
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLsizeiptr bufferSize = (GLsizeiptr)m_RegionSize * m_RegionCount;
+
+		//Without a gpu the vertices are still written, just into plain memory
+		if (RendererAPI::IsNull())
+		{
+			m_MappedData = new uint8_t[bufferSize];
+			return;
+		}
+
+		glCreateBuffers(1, &m_BufferId);
+		glNamedBufferStorage(m_BufferId, bufferSize, nullptr, flags);
+		m_MappedData = (uint8_t*)glMapNamedBufferRange(m_BufferId, 0, bufferSize, flags);
+		ME_ASSERT(m_MappedData, "Stream buffer mapping failed!");
+	}
+
+	void* StreamBuffer::Allocate(uint32_t size, uint32_t alignment, uint32_t& offset)
+	{
+		ME_ASSERT((size <= m_RegionSize), "Stream buffer allocation is bigger than a region!");
+
+		uint32_t regionStart = m_Region * m_RegionSize;
+		uint32_t alignedOffset = ((regionStart + m_Cursor + alignment - 1) / alignment) * alignment;
+
+		if (alignedOffset + size > regionStart + m_RegionSize)
+		{
+			NextRegion();
+
+			regionStart = m_Region * m_RegionSize;
+			alignedOffset = ((regionStart + alignment - 1) / alignment) * alignment;
+		}
+
+		m_Cursor = alignedOffset + size - regionStart;
+		m_UnfencedRegions |= 1u << m_Region;
+		offset = alignedOffset;
+		return m_MappedData + alignedOffset;
+	}
+
+	void StreamBuffer::Fence()
+	{
+		if (RendererAPI::IsNull())
+		{
+			m_UnfencedRegions = 0;
+			return;
+		}
+
+		for (uint32_t region = 0; region < m_RegionCount; region++)
+		{
+			if (!(m_UnfencedRegions & (1u << region)))
+				continue;
+
+			//The fence signals once every draw submitted so far, including the ones reading this region, is done
+			if (m_Fences[region])
+				glDeleteSync((GLsync)m_Fences[region]);
+			m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		m_UnfencedRegions = 0;
+	}
+
+	void StreamBuffer::NextRegion()
+	{
+		m_Region = (m_Region + 1) % m_RegionCount;
+		m_Cursor = 0;
+
+		ME_ASSERT((!(m_UnfencedRegions & (1u << m_Region))), "Stream buffer wrapped around before its draws were fenced!");
+		WaitFence(m_Region);
+	}
+
+	void StreamBuffer::WaitFence(uint32_t region)
+	{
+		GLsync fence = (GLsync)m_Fences[region];
+		if (!fence)
+			return;
+
+		GLbitfield waitFlags = 0;
+		GLuint64 waitDuration = 0;
+		while (true)
+		{
+			GLenum result = glClientWaitSync(fence, waitFlags, waitDuration);
+			if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+				break;
+
+			//First poll failed, flush the command queue so the fence can actually signal and wait for real
+			waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+			waitDuration = 1000000;
+		}
+
+		glDeleteSync(fence);
+		m_Fences[region] = nullptr;
+	}
+
+	StreamBuffer::~StreamBuffer()
+	{
+		if (RendererAPI::IsNull())
+		{
+			delete[] m_MappedData;
+			return;
+		}
+
+		for (void* fence : m_Fences)
+			if (fence)
+				glDeleteSync((GLsync)fence);
+
+		glUnmapNamedBuffer(m_BufferId);
+		glDeleteBuffers(1, &m_BufferId);
+	}
+}
\ No newline at end of file
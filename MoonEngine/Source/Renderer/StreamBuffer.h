@@ -0,0 +1,39 @@
+#pragma once
+
+namespace MoonEngine
+{
+	//Persistently mapped buffer split into regions. Each region is guarded by a fence so the cpu never writes into memory the gpu is still reading
+	class StreamBuffer
+	{
+	public:
+		StreamBuffer(uint32_t regionSize, uint32_t regionCount = 3);
+		StreamBuffer(const StreamBuffer&) = delete;
+		StreamBuffer& operator=(const StreamBuffer&) = delete;
+		~StreamBuffer();
+
+		//Returns a pointer into mapped memory with room for size bytes. offset is the position of that memory inside the buffer and is a multiple of alignment
+		void* Allocate(uint32_t size, uint32_t alignment, uint32_t& offset);
+		//Guards every region written since the last call, call it once the draws reading them are submitted
+		void Fence();
+
+		uint32_t GetBufferId() const { return m_BufferId; }
+		uint32_t GetRegionSize() const { return m_RegionSize; }
+		uint32_t GetRegionCount() const { return m_RegionCount; }
+	private:
+		uint32_t m_BufferId = 0;
+		uint8_t* m_MappedData = nullptr;
+
+		uint32_t m_RegionSize = 0;
+		uint32_t m_RegionCount = 0;
+		uint32_t m_Region = 0;
+		uint32_t m_Cursor = 0;
+		//Bit per region written since the last fence
+		uint32_t m_UnfencedRegions = 0;
+
+		//GLsync handles, kept opaque so glad stays out of the header
+		std::vector<void*> m_Fences;
+
+		void NextRegion();
+		void WaitFence(uint32_t region);
+	};
+}
\ No newline at end of file
@@ -2,8 +2,9 @@
 #include "Renderer/Texture.h"
 
 #include "Core/Debug.h"
+#include "Renderer/CookedTexture.h"
+#include "Renderer/RendererAPI.h"
 
-#include <stb_image.h>
 #include <glad/glad.h>
 
 namespace MoonEngine
@@ -24,35 +25,39 @@ namespace MoonEngine
 		m_Width = width;
 		m_Height = height;
 		m_Channels = 4;
+		m_AlphaMode = AlphaMode::Translucent;
+
+		if (RendererAPI::IsNull())
+			return;
 
-		GenerateTextureProps();
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureId);
+		GenerateTextureProps();
 		glTextureStorage2D(m_TextureId, 1, GL_RGBA8, m_Width, m_Height);
 	}
 
 	Texture::Texture(const std::string& path, TextureProps props)
 		:m_Props(props)
 	{
-		int width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
-		unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+		Unique<CookedTexture> image = CookedTexture::Open(path, m_Props.GenerateMipmap);
 
-		if (data)
+		if (image)
 		{
 			m_Path = path;
-			m_Width = width;
-			m_Height = height;
-			m_Channels = channels;
-			SetTexture(data);
+			m_AlphaMode = image->GetAlphaMode();
+			Allocate(image->GetWidth(), image->GetHeight(), image->GetLevelCount());
+			for (uint32_t i = 0; i < image->GetLevelCount(); i++)
+				SetData(image->GetLevel(i).Pixels, i);
 		}
 		else
 			ME_SYS_WAR("Texture Creation Failed!");
-
-		stbi_image_free(data);
 	}
 
 	void Texture::SetTexture(void* data)
 	{
+		//The size is all the null backend keeps of a texture
+		if (RendererAPI::IsNull())
+			return;
+
 		glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureId);
 
 		GenerateTextureProps();
@@ -63,71 +68,119 @@ namespace MoonEngine
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	void Texture::Allocate(uint32_t width, uint32_t height, uint32_t levels)
+	{
+		m_Width = width;
+		m_Height = height;
+		m_Channels = 4;
+		m_Levels = levels;
+
+		if (RendererAPI::IsNull())
+			return;
+
+		glDeleteTextures(1, &m_TextureId);
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureId);
+
+		GenerateTextureProps();
+
+		glTextureStorage2D(m_TextureId, m_Levels, GL_RGBA8, m_Width, m_Height);
+	}
+
 	void Texture::GenerateTextureProps()
 	{
 		switch (m_Props.WrapMode)
 		{
 			case WrapMode::Repeat:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_S, GL_REPEAT);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_T, GL_REPEAT);
 				break;
 			case WrapMode::MirroredRepeat:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
 				break;
 			case WrapMode::EdgeClamp:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 				break;
 			case WrapMode::BorderClamp:
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 				break;
 		}
 
 		switch (m_Props.FilterType)
 		{
 			case FilterType::Linear:
-				if (m_Props.GenerateMipmap)
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+				if (m_Levels > 1)
+					glTextureParameteri(m_TextureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 				else
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+					glTextureParameteri(m_TextureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 				break;
 
 			case FilterType::Nearest:
-				if (m_Props.GenerateMipmap)
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+				if (m_Levels > 1)
+					glTextureParameteri(m_TextureId, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
 				else
-					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+					glTextureParameteri(m_TextureId, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
-				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+				glTextureParameteri(m_TextureId, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 				break;
 		}
 
-		if (m_Props.GenerateMipmap)
-			glGenerateMipmap(GL_TEXTURE_2D);
 	}
 
-	void Texture::SetData(void* data)
+	void Texture::SetData(const void* data, uint32_t level)
 	{
-		glTextureSubImage2D(m_TextureId, 0, 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		if (RendererAPI::IsNull())
+			return;
+
+		glTextureSubImage2D(m_TextureId, level, 0, 0, std::max(m_Width >> level, 1u), std::max(m_Height >> level, 1u), GL_RGBA, GL_UNSIGNED_BYTE, data);
+	}
+
+	float Texture::SampleAlpha(const glm::vec2& uv) const
+	{
+		if (!m_Loaded || m_Path.empty())
+			return 1.0f;
+
+		if (!m_Image)
+			m_Image = CookedTexture::Open(m_Path, m_Props.GenerateMipmap, true);
+
+		if (!m_Image)
+			return 1.0f;
+
+		bool clamped = m_Props.WrapMode == WrapMode::EdgeClamp || m_Props.WrapMode == WrapMode::BorderClamp;
+		glm::vec2 wrapped = clamped ? glm::clamp(uv, 0.0f, 1.0f) : glm::fract(uv);
+
+		const CookedLevel& level = m_Image->GetLevel(0);
+		uint32_t x = std::min((uint32_t)(wrapped.x * level.Width), level.Width - 1);
+		uint32_t y = std::min((uint32_t)(wrapped.y * level.Height), level.Height - 1);
+		return level.Pixels[(y * level.Width + x) * 4 + 3] / 255.0f;
 	}
 
 	void Texture::Bind(uint32_t slot) const
 	{
+		if (RendererAPI::IsNull())
+			return;
+
 		glActiveTexture(GL_TEXTURE0 + slot);
 		glBindTexture(GL_TEXTURE_2D, m_TextureId);
 	}
 
 	void Texture::Unbind() const
 	{
+		if (RendererAPI::IsNull())
+			return;
+
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	Texture::~Texture()
 	{
+		if (RendererAPI::IsNull())
+			return;
+
 		glDeleteTextures(1, &m_TextureId);
 	}
 }
\ No newline at end of file
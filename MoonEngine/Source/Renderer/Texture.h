@@ -2,6 +2,8 @@
 
 namespace MoonEngine
 {
+	class CookedTexture;
+
 	enum class WrapMode
 	{
 		Repeat,
@@ -16,10 +18,20 @@ namespace MoonEngine
 		Linear
 	};
 
+	//Coverage of the alpha channel, sprites with an opaque or cutout texture can be drawn in the depth tested pass
+	enum class AlphaMode : uint32_t
+	{
+		Opaque,
+		//Every texel is either fully opaque or fully transparent
+		Cutout,
+		Translucent
+	};
+
 	struct TextureProps
 	{
 		WrapMode WrapMode = WrapMode::Repeat;
 		FilterType FilterType = FilterType::Nearest;
+		//The mip chain is built on the cpu when the source is cooked, loads only upload it
 		bool GenerateMipmap = false;
 	};
 
@@ -31,7 +43,7 @@ namespace MoonEngine
 		Texture(TextureProps props = {});
 		~Texture();
 
-		void SetData(void* data);
+		void SetData(const void* data, uint32_t level = 0);
 		void Bind(uint32_t slot = 0) const;
 		void Unbind() const;
 
@@ -39,6 +51,15 @@ namespace MoonEngine
 		uint32_t GetTextureId() const { return m_TextureId; }
 		uint32_t GetWidth() const { return m_Width; };
 		uint32_t GetHeight() const { return m_Height; };
+		uint32_t GetLevelCount() const { return m_Levels; }
+		const TextureProps& GetProps() const { return m_Props; }
+		//False while TextureLoader still holds the white placeholder in its place
+		bool IsLoaded() const { return m_Loaded; }
+		//Found when the source is cooked. Textures filled through SetData are assumed translucent
+		AlphaMode GetAlphaMode() const { return m_AlphaMode; }
+
+		//Cpu side lookup for picking, level 0 of the cooked file is mapped on the first call. Textures without a file are opaque
+		float SampleAlpha(const glm::vec2& uv) const;
 	private:
 		std::filesystem::path m_Path;
 		TextureProps m_Props;
@@ -47,8 +68,16 @@ namespace MoonEngine
 		uint32_t m_Width = 0;
 		uint32_t m_Height = 0;
 		uint32_t m_Channels = 0;
+		uint32_t m_Levels = 1;
+		bool m_Loaded = true;
+		AlphaMode m_AlphaMode = AlphaMode::Opaque;
+		mutable Unique<CookedTexture> m_Image;
 
 		void SetTexture(void* data);
 		void GenerateTextureProps();
+		//Swaps the placeholder for empty storage of the real size, the pixels are uploaded after
+		void Allocate(uint32_t width, uint32_t height, uint32_t levels = 1);
+
+		friend class TextureLoader;
 	};
 }
\ No newline at end of file
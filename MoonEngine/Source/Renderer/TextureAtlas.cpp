@@ -0,0 +1,210 @@
+#include "mpch.h"
+#include "Renderer/TextureAtlas.h"
+
+#include "Renderer/RendererAPI.h"
+#include "Renderer/Texture.h"
+
+#include <unordered_set>
+
+namespace MoonEngine
+{
+	TextureAtlas::TextureAtlas(uint32_t pageSize, uint32_t maxTextureSize, uint32_t padding)
+		:m_PageSize(pageSize), m_Padding(padding)
+	{
+		SetMaxTextureSize(maxTextureSize);
+	}
+
+	const AtlasRegion* TextureAtlas::GetRegion(const Shared<Texture>& texture)
+	{
+		//A destroyed texture can hand its address to a new one, the weak pointer tells them apart
+		auto it = m_Entries.find(texture.get());
+		if (it != m_Entries.end() && !it->second.Source.expired())
+			return &it->second.Region;
+
+		uint32_t width = texture->GetWidth();
+		uint32_t height = texture->GetHeight();
+		if (width == 0 || height == 0 || width > m_MaxTextureSize || height > m_MaxTextureSize || !CanShare(*texture))
+			return nullptr;
+
+		uint32_t paddedWidth = width + m_Padding * 2;
+		uint32_t paddedHeight = height + m_Padding * 2;
+		uint32_t x = 0;
+		uint32_t y = 0;
+
+		AtlasPage* page = nullptr;
+		for (AtlasPage& candidate : m_Pages)
+		{
+			if (Insert(candidate, paddedWidth, paddedHeight, x, y))
+			{
+				page = &candidate;
+				break;
+			}
+		}
+
+		if (!page)
+		{
+			page = &CreatePage();
+			Insert(*page, paddedWidth, paddedHeight, x, y);
+		}
+
+		Copy(*texture, *page, x + m_Padding, y + m_Padding);
+
+		AtlasEntry& entry = m_Entries[texture.get()];
+		entry.Source = texture;
+		entry.Region.Page = page->PageTexture;
+		entry.Region.Rect =
+		{
+			(float)(x + m_Padding) / m_PageSize, (float)(y + m_Padding) / m_PageSize,
+			(float)width / m_PageSize, (float)height / m_PageSize
+		};
+		return &entry.Region;
+	}
+
+	void TextureAtlas::Collect()
+	{
+		//Pages only empty out when an entry goes, most frames stop here
+		size_t entryCount = m_Entries.size();
+		for (auto it = m_Entries.begin(); it != m_Entries.end();)
+		{
+			if (it->second.Source.expired())
+				it = m_Entries.erase(it);
+			else
+				++it;
+		}
+
+		if (m_Entries.size() == entryCount)
+			return;
+
+		std::unordered_set<const Texture*> usedPages;
+		for (const auto& [texture, entry] : m_Entries)
+			usedPages.insert(entry.Region.Page.get());
+
+		//Space freed inside a page that is still used stays lost until the page empties, draws in flight keep a dropped page alive
+		m_Pages.erase(std::remove_if(m_Pages.begin(), m_Pages.end(), [&](const AtlasPage& page)
+		{
+			return usedPages.find(page.PageTexture.get()) == usedPages.end();
+		}), m_Pages.end());
+	}
+
+	bool TextureAtlas::CanShare(const Texture& texture) const
+	{
+		//Pages are nearest filtered, repeating and have no mips, anything else would silently change how the texture samples
+		const TextureProps pageProps;
+		const TextureProps& props = texture.GetProps();
+		return props.FilterType == pageProps.FilterType && props.WrapMode == pageProps.WrapMode &&
+			props.GenerateMipmap == pageProps.GenerateMipmap && texture.GetLevelCount() == 1;
+	}
+
+	TextureAtlas::AtlasPage& TextureAtlas::CreatePage()
+	{
+		AtlasPage& page = m_Pages.emplace_back();
+		page.PageTexture = MakeShared<Texture>(m_PageSize, m_PageSize);
+		page.Skyline.push_back({ 0, 0, m_PageSize });
+
+		RendererAPI::Get()->ClearTexture(*page.PageTexture);
+		return page;
+	}
+
+	bool TextureAtlas::Fit(const AtlasPage& page, uint32_t index, uint32_t width, uint32_t height, uint32_t& y) const
+	{
+		//The rectangle rests on the highest skyline segment it spans
+		const std::vector<SkylineNode>& skyline = page.Skyline;
+		if (skyline[index].X + width > m_PageSize)
+			return false;
+
+		y = skyline[index].Y;
+		int32_t widthLeft = (int32_t)width;
+		while (widthLeft > 0)
+		{
+			y = std::max(y, skyline[index].Y);
+			if (y + height > m_PageSize)
+				return false;
+
+			widthLeft -= (int32_t)skyline[index].Width;
+			index++;
+		}
+		return true;
+	}
+
+	bool TextureAtlas::Insert(AtlasPage& page, uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+	{
+		std::vector<SkylineNode>& skyline = page.Skyline;
+
+		//Bottom left rule, lowest resting position first and the narrowest segment on ties
+		uint32_t bestIndex = UINT32_MAX;
+		uint32_t bestY = UINT32_MAX;
+		uint32_t bestWidth = UINT32_MAX;
+
+		for (uint32_t i = 0; i < (uint32_t)skyline.size(); i++)
+		{
+			uint32_t fitY = 0;
+			if (!Fit(page, i, width, height, fitY))
+				continue;
+
+			if (fitY < bestY || (fitY == bestY && skyline[i].Width < bestWidth))
+			{
+				bestIndex = i;
+				bestY = fitY;
+				bestWidth = skyline[i].Width;
+			}
+		}
+
+		if (bestIndex == UINT32_MAX)
+			return false;
+
+		x = skyline[bestIndex].X;
+		y = bestY;
+		skyline.insert(skyline.begin() + bestIndex, { x, y + height, width });
+
+		//Cut away the segments now covered by the new one
+		for (size_t i = bestIndex + 1; i < skyline.size(); i++)
+		{
+			const SkylineNode& previous = skyline[i - 1];
+			uint32_t previousEnd = previous.X + previous.Width;
+			if (skyline[i].X >= previousEnd)
+				break;
+
+			uint32_t shrink = previousEnd - skyline[i].X;
+			if (shrink < skyline[i].Width)
+			{
+				skyline[i].X += shrink;
+				skyline[i].Width -= shrink;
+				break;
+			}
+
+			skyline.erase(skyline.begin() + i);
+			i--;
+		}
+
+		for (size_t i = 0; i + 1 < skyline.size(); i++)
+		{
+			if (skyline[i].Y == skyline[i + 1].Y)
+			{
+				skyline[i].Width += skyline[i + 1].Width;
+				skyline.erase(skyline.begin() + i + 1);
+				i--;
+			}
+		}
+
+		return true;
+	}
+
+	void TextureAtlas::Copy(const Texture& source, const AtlasPage& page, uint32_t x, uint32_t y)
+	{
+		RendererAPI* api = RendererAPI::Get();
+		const Texture& pageTexture = *page.PageTexture;
+		uint32_t width = source.GetWidth();
+		uint32_t height = source.GetHeight();
+
+		api->CopyTexture(source, 0, 0, pageTexture, x, y, width, height);
+
+		//Repeat the border texels into the padding so filtering never picks up a neighbour
+		for (uint32_t i = 1; i <= m_Padding; i++)
+		{
+			api->CopyTexture(source, 0, 0, pageTexture, x, y - i, width, 1);
+			api->CopyTexture(source, 0, height - 1, pageTexture, x, y + height - 1 + i, width, 1);
+			api->CopyTexture(source, 0, 0, pageTexture, x - i, y, 1, height);
+			api->CopyTexture(source, width - 1, 0, pageTexture, x + width - 1 + i, y, 1, height);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+namespace MoonEngine
+{
+	class Texture;
+
+	struct AtlasRegion
+	{
+		Shared<Texture> Page;
+		//xy is the offset of the texture inside the page, zw its size. Both in uv space
+		glm::vec4 Rect = { 0.0f, 0.0f, 1.0f, 1.0f };
+	};
+
+	//Packs small textures into shared pages so sprites using them can be drawn with a single texture slot
+	//Pages are filled with a skyline packer, new textures are copied in on the gpu the first time they are requested
+	//Only textures sampled like a page are packed: default props and a single level
+	class TextureAtlas
+	{
+	public:
+		TextureAtlas(uint32_t pageSize = 2048, uint32_t maxTextureSize = 256, uint32_t padding = 2);
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		//Returns nullptr if the texture is too big to be shared or is sampled differently from the pages
+		const AtlasRegion* GetRegion(const Shared<Texture>& texture);
+		//Forgets destroyed textures and drops the pages none of the live ones use, so reloads do not keep adding pages
+		void Collect();
+
+		//Only affects textures that are not packed yet, 0 turns packing off
+		void SetMaxTextureSize(uint32_t size) { m_MaxTextureSize = std::min(size, m_PageSize - m_Padding * 2); }
+		uint32_t GetMaxTextureSize() const { return m_MaxTextureSize; }
+		uint32_t GetPageCount() const { return (uint32_t)m_Pages.size(); }
+	private:
+		struct SkylineNode
+		{
+			uint32_t X;
+			uint32_t Y;
+			uint32_t Width;
+		};
+
+		struct AtlasPage
+		{
+			Shared<Texture> PageTexture;
+			std::vector<SkylineNode> Skyline;
+		};
+
+		struct AtlasEntry
+		{
+			Weak<Texture> Source;
+			AtlasRegion Region;
+		};
+
+		uint32_t m_PageSize;
+		uint32_t m_MaxTextureSize;
+		uint32_t m_Padding;
+
+		std::vector<AtlasPage> m_Pages;
+		std::unordered_map<const Texture*, AtlasEntry> m_Entries;
+
+		AtlasPage& CreatePage();
+		bool CanShare(const Texture& texture) const;
+		bool Insert(AtlasPage& page, uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+		bool Fit(const AtlasPage& page, uint32_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+		void Copy(const Texture& source, const AtlasPage& page, uint32_t x, uint32_t y);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "mpch.h"
+#include "Renderer/TextureLoader.h"
+
+#include "Renderer/CookedTexture.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/RendererAPI.h"
+#include "Renderer/StreamBuffer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace MoonEngine
+{
+	//Bytes uploaded per frame, also the size of a staging region
+	const uint32_t UploadBudget = 4 * 1024 * 1024;
+	const uint32_t StagingRegions = 3;
+
+	struct TextureRequest
+	{
+		Weak<Texture> Target;
+		const Texture* Key;
+		std::string Path;
+		bool Mipmaps = false;
+		std::vector<std::function<void()>> Callbacks;
+
+		//Filled by a worker, null when the file could not be read
+		Unique<CookedTexture> Image;
+
+		uint32_t GetSize() const { return Image ? Image->GetSize() : 0; }
+	};
+
+	struct LoaderData
+	{
+		std::vector<std::thread> Workers;
+		std::mutex Mutex;
+		std::condition_variable JobReady;
+		bool Running = true;
+
+		//Requests waiting for a worker and requests waiting for their upload, oldest first
+		std::deque<Shared<TextureRequest>> DecodeQueue;
+		std::deque<Shared<TextureRequest>> UploadQueue;
+
+		//Every request that is not resident yet, only touched on the main thread
+		std::unordered_map<const Texture*, Shared<TextureRequest>> Pending;
+
+		Unique<StreamBuffer> Staging;
+	};
+
+	static LoaderData* s_Loader;
+
+	static void DecodeLoop(LoaderData* loader)
+	{
+		while (true)
+		{
+			Shared<TextureRequest> request;
+			{
+				std::unique_lock<std::mutex> lock(loader->Mutex);
+				loader->JobReady.wait(lock, [loader] { return !loader->DecodeQueue.empty() || !loader->Running; });
+
+				if (!loader->Running)
+					return;
+
+				request = std::move(loader->DecodeQueue.front());
+				loader->DecodeQueue.pop_front();
+			}
+
+			//Nobody holds the texture anymore, decoding it would be wasted
+			if (!request->Target.expired())
+				request->Image = CookedTexture::Open(request->Path, request->Mipmaps);
+
+			std::scoped_lock<std::mutex> lock(loader->Mutex);
+			loader->UploadQueue.push_back(request);
+		}
+	}
+
+	void TextureLoader::Init()
+	{
+		s_Loader = new LoaderData();
+		s_Loader->Staging = MakeUnique<StreamBuffer>(UploadBudget, StagingRegions);
+
+		uint32_t workerCount = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Loader->Workers.emplace_back(DecodeLoop, s_Loader);
+	}
+
+	void TextureLoader::Terminate()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(s_Loader->Mutex);
+			s_Loader->Running = false;
+		}
+		s_Loader->JobReady.notify_all();
+
+		for (std::thread& worker : s_Loader->Workers)
+			worker.join();
+
+		delete s_Loader;
+		s_Loader = nullptr;
+	}
+
+	Shared<Texture> TextureLoader::Load(const std::string& path, TextureProps props)
+	{
+		Shared<Texture> texture = MakeShared<Texture>(props);
+		texture->m_Path = path;
+		texture->m_Loaded = false;
+
+		Shared<TextureRequest> request = MakeShared<TextureRequest>();
+		request->Target = texture;
+		request->Key = texture.get();
+		request->Path = path;
+		request->Mipmaps = props.GenerateMipmap;
+		s_Loader->Pending[texture.get()] = request;
+
+		{
+			std::scoped_lock<std::mutex> lock(s_Loader->Mutex);
+			s_Loader->DecodeQueue.push_back(request);
+		}
+		s_Loader->JobReady.notify_one();
+
+		return texture;
+	}
+
+	void TextureLoader::OnLoaded(const Shared<Texture>& texture, const std::function<void()>& func)
+	{
+		auto it = s_Loader->Pending.find(texture.get());
+		if (texture->IsLoaded() || it == s_Loader->Pending.end() || it->second->Target.lock() != texture)
+		{
+			func();
+			return;
+		}
+
+		it->second->Callbacks.push_back(func);
+	}
+
+	uint32_t TextureLoader::GetPendingCount()
+	{
+		return (uint32_t)s_Loader->Pending.size();
+	}
+
+	void TextureLoader::Update(RendererStats& frame)
+	{
+		RendererAPI* api = RendererAPI::Get();
+		StreamBuffer& staging = *s_Loader->Staging;
+		uint32_t uploaded = 0;
+		uint32_t staged = 0;
+
+		while (true)
+		{
+			Shared<TextureRequest> request;
+			{
+				std::scoped_lock<std::mutex> lock(s_Loader->Mutex);
+				if (s_Loader->UploadQueue.empty())
+					break;
+
+				//A texture over the budget still goes up, alone in its frame
+				uint32_t size = s_Loader->UploadQueue.front()->GetSize();
+				if (uploaded > 0 && uploaded + size > UploadBudget)
+					break;
+
+				request = std::move(s_Loader->UploadQueue.front());
+				s_Loader->UploadQueue.pop_front();
+			}
+
+			s_Loader->Pending.erase(request->Key);
+
+			Shared<Texture> texture = request->Target.lock();
+			if (!texture)
+				continue;
+
+			if (const CookedTexture* image = request->Image.get())
+			{
+				texture->Allocate(image->GetWidth(), image->GetHeight(), image->GetLevelCount());
+				texture->m_AlphaMode = image->GetAlphaMode();
+
+				//At most one region is staged per frame, levels that do not fit go straight from the mapped file
+				for (uint32_t i = 0; i < image->GetLevelCount(); i++)
+				{
+					const CookedLevel& level = image->GetLevel(i);
+					if (staged + level.Size <= staging.GetRegionSize())
+					{
+						uint32_t offset = 0;
+						void* memory = staging.Allocate(level.Size, 4, offset);
+						memcpy(memory, level.Pixels, level.Size);
+						api->UploadTexture(*texture, i, staging.GetBufferId(), offset);
+						staged += level.Size;
+					}
+					else
+						texture->SetData(level.Pixels, i);
+				}
+
+				uploaded += image->GetSize();
+			}
+			else
+				ME_SYS_WAR("Texture Creation Failed! Path: {0}", request->Path);
+
+			//A failed texture stays white but is done loading
+			texture->m_Loaded = true;
+			for (const std::function<void()>& callback : request->Callbacks)
+				callback();
+		}
+
+		staging.Fence();
+		frame.UploadBytes += uploaded;
+	}
+}
\ No newline at end of file
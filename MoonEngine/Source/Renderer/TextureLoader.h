@@ -0,0 +1,26 @@
+#pragma once
+#include "Renderer/Texture.h"
+
+namespace MoonEngine
+{
+	struct RendererStats;
+
+	//Decodes or maps cooked image files on worker threads and uploads them on the gl thread through a staging ring, a few megabytes per frame
+	//Load returns at once with a white 1x1 texture that turns into the real one in place, holders never have to swap pointers
+	class TextureLoader
+	{
+	public:
+		static Shared<Texture> Load(const std::string& path, TextureProps props = {});
+		//Runs func on the main thread once the texture is resident, right away when it already is
+		static void OnLoaded(const Shared<Texture>& texture, const std::function<void()>& func);
+
+		static uint32_t GetPendingCount();
+	private:
+		static void Init();
+		static void Terminate();
+		//Uploads what the workers decoded within the frame budget and runs the callbacks of the finished textures
+		static void Update(RendererStats& frame);
+
+		friend class Renderer;
+	};
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Renderer/TextureSheet.h"
 
 #include "Renderer/Texture.h"
+#include "Renderer/TextureLoader.h"
 
 namespace MoonEngine
 {
@@ -9,6 +10,12 @@ namespace MoonEngine
 	{
 		m_Texture = texture;
 		CalculateTexCoords();
+
+		TextureLoader::OnLoaded(texture, [sheet = weak_from_this()]
+		{
+			if (Shared<TextureSheet> owner = sheet.lock())
+				owner->CalculateTexCoords();
+		});
 	}
 
 	void TextureSheet::CalculateTexCoords()
@@ -4,9 +4,10 @@ namespace MoonEngine
 {
 	class Texture;
 
-	class TextureSheet
+	class TextureSheet : public std::enable_shared_from_this<TextureSheet>
 	{
 	public:
+		//Cell uvs follow the texture size, a texture still loading recalculates them once it is resident
 		void Create(Shared<Texture>& texture);
 
 		const glm::vec2& GetTexCoord(int i) const { return m_TextureCoords[i]; }
@@ -0,0 +1,185 @@
+#include "mpch.h"
+#include "Renderer/Tilemap.h"
+
+#include "Renderer/RendererAPI.h"
+
+namespace MoonEngine
+{
+	static uint64_t ChunkKey(const glm::ivec2& coord)
+	{
+		return ((uint64_t)(uint32_t)coord.x << 32) | (uint32_t)coord.y;
+	}
+
+	//Rounds towards negative infinity so cells left of or below the origin land in their own chunk
+	static int FloorDiv(int value, int divisor)
+	{
+		return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+	}
+
+	Tilemap::Tilemap(const Tilemap& other)
+	{
+		*this = other;
+	}
+
+	Tilemap& Tilemap::operator=(const Tilemap& other)
+	{
+		if (this == &other)
+			return *this;
+
+		ReleaseBuffers();
+		m_Chunks.clear();
+
+		for (const TileChunk& source : other.m_Chunks)
+		{
+			TileChunk& chunk = m_Chunks.emplace_back();
+			chunk.Coord = source.Coord;
+			chunk.Tiles = source.Tiles;
+			chunk.TileCount = source.TileCount;
+		}
+
+		m_ChunkLookup = other.m_ChunkLookup;
+		m_TileCount = other.m_TileCount;
+		return *this;
+	}
+
+	Tilemap& Tilemap::operator=(Tilemap&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		ReleaseBuffers();
+		m_Chunks = std::move(other.m_Chunks);
+		m_ChunkLookup = std::move(other.m_ChunkLookup);
+		m_TileCount = other.m_TileCount;
+		m_Transform = other.m_Transform;
+		m_Tileset = std::move(other.m_Tileset);
+		m_TileSize = other.m_TileSize;
+		m_Color = other.m_Color;
+		m_Layer = other.m_Layer;
+
+		other.m_Chunks.clear();
+		other.m_ChunkLookup.clear();
+		other.m_TileCount = 0;
+		return *this;
+	}
+
+	void Tilemap::SetTile(const glm::ivec2& cell, int tile)
+	{
+		glm::ivec2 coord = { FloorDiv(cell.x, ChunkSize), FloorDiv(cell.y, ChunkSize) };
+		TileChunk* chunk = tile < 0 ? FindChunk(coord) : &GetOrCreateChunk(coord);
+		if (!chunk)
+			return;
+
+		glm::ivec2 local = cell - coord * ChunkSize;
+		uint16_t& stored = chunk->Tiles[local.y * ChunkSize + local.x];
+		uint16_t value = tile < 0 ? EmptyTile : (uint16_t)std::min(tile + 1, (int)UINT16_MAX);
+		if (stored == value)
+			return;
+
+		if (stored == EmptyTile)
+		{
+			chunk->TileCount++;
+			m_TileCount++;
+		}
+		else if (value == EmptyTile)
+		{
+			chunk->TileCount--;
+			m_TileCount--;
+		}
+
+		stored = value;
+		chunk->Dirty = true;
+	}
+
+	int Tilemap::GetTile(const glm::ivec2& cell) const
+	{
+		glm::ivec2 coord = { FloorDiv(cell.x, ChunkSize), FloorDiv(cell.y, ChunkSize) };
+		const TileChunk* chunk = FindChunk(coord);
+		if (!chunk)
+			return -1;
+
+		glm::ivec2 local = cell - coord * ChunkSize;
+		return (int)chunk->Tiles[local.y * ChunkSize + local.x] - 1;
+	}
+
+	void Tilemap::Fill(const glm::ivec2& min, const glm::ivec2& max, int tile)
+	{
+		for (int y = min.y; y <= max.y; y++)
+			for (int x = min.x; x <= max.x; x++)
+				SetTile({ x, y }, tile);
+	}
+
+	void Tilemap::Clear()
+	{
+		ReleaseBuffers();
+		m_Chunks.clear();
+		m_ChunkLookup.clear();
+		m_TileCount = 0;
+	}
+
+	void Tilemap::SetChunkTiles(const glm::ivec2& coord, const uint16_t* tiles)
+	{
+		TileChunk& chunk = GetOrCreateChunk(coord);
+		m_TileCount -= chunk.TileCount;
+
+		chunk.TileCount = 0;
+		for (uint32_t i = 0; i < ChunkTiles; i++)
+		{
+			chunk.Tiles[i] = tiles[i];
+			chunk.TileCount += tiles[i] != EmptyTile;
+		}
+
+		m_TileCount += chunk.TileCount;
+		chunk.Dirty = true;
+	}
+
+	bool Tilemap::SetBakeState(const glm::mat4& transform, const Shared<Texture>& tileset, const glm::vec2& tileSize, const glm::vec4& color, int layer)
+	{
+		if (transform == m_Transform && tileset == m_Tileset && tileSize == m_TileSize && color == m_Color && layer == m_Layer)
+			return false;
+
+		m_Transform = transform;
+		m_Tileset = tileset;
+		m_TileSize = tileSize;
+		m_Color = color;
+		m_Layer = layer;
+
+		for (TileChunk& chunk : m_Chunks)
+			chunk.Dirty = true;
+		return true;
+	}
+
+	Tilemap::TileChunk* Tilemap::FindChunk(const glm::ivec2& coord)
+	{
+		auto it = m_ChunkLookup.find(ChunkKey(coord));
+		return it != m_ChunkLookup.end() ? &m_Chunks[it->second] : nullptr;
+	}
+
+	const Tilemap::TileChunk* Tilemap::FindChunk(const glm::ivec2& coord) const
+	{
+		auto it = m_ChunkLookup.find(ChunkKey(coord));
+		return it != m_ChunkLookup.end() ? &m_Chunks[it->second] : nullptr;
+	}
+
+	Tilemap::TileChunk& Tilemap::GetOrCreateChunk(const glm::ivec2& coord)
+	{
+		auto [it, inserted] = m_ChunkLookup.try_emplace(ChunkKey(coord), (uint32_t)m_Chunks.size());
+		if (!inserted)
+			return m_Chunks[it->second];
+
+		TileChunk& chunk = m_Chunks.emplace_back();
+		chunk.Coord = coord;
+		return chunk;
+	}
+
+	void Tilemap::ReleaseBuffers()
+	{
+		for (TileChunk& chunk : m_Chunks)
+			chunk.Buffer.Release();
+	}
+
+	Tilemap::~Tilemap()
+	{
+		ReleaseBuffers();
+	}
+}
\ No newline at end of file
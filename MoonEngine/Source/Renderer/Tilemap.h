@@ -0,0 +1,77 @@
+#pragma once
+#include "Renderer/ChunkBuffer.h"
+
+namespace MoonEngine
+{
+	class Texture;
+
+	//Tile indices stored in fixed size chunks, each chunk is baked into its own gpu buffer by Renderer::DrawTilemap
+	//Editing a tile re-meshes only its chunk, chunks are culled against the view one by one
+	class Tilemap
+	{
+	public:
+		static constexpr int ChunkSize = 32;
+		static constexpr uint32_t ChunkTiles = ChunkSize * ChunkSize;
+		//Stored in chunk tiles as the tile index plus one
+		static constexpr uint16_t EmptyTile = 0;
+
+		Tilemap() = default;
+		//Copies take the tiles only, their chunks are baked again the first time they are drawn
+		Tilemap(const Tilemap& other);
+		Tilemap& operator=(const Tilemap& other);
+		Tilemap(Tilemap&& other) noexcept = default;
+		Tilemap& operator=(Tilemap&& other) noexcept;
+		~Tilemap();
+
+		//Index of a tileset cell counted row by row from the top left, -1 clears the tile
+		void SetTile(const glm::ivec2& cell, int tile);
+		int GetTile(const glm::ivec2& cell) const;
+		void Fill(const glm::ivec2& min, const glm::ivec2& max, int tile);
+		void Clear();
+
+		uint32_t GetTileCount() const { return m_TileCount; }
+		uint32_t GetChunkCount() const { return (uint32_t)m_Chunks.size(); }
+
+		//Bulk access for serialization, tiles are ChunkTiles values laid out row by row
+		const glm::ivec2& GetChunkCoord(uint32_t chunk) const { return m_Chunks[chunk].Coord; }
+		const uint16_t* GetChunkTiles(uint32_t chunk) const { return m_Chunks[chunk].Tiles.data(); }
+		void SetChunkTiles(const glm::ivec2& coord, const uint16_t* tiles);
+	private:
+		struct TileChunk
+		{
+			glm::ivec2 Coord = glm::ivec2(0);
+			std::vector<uint16_t> Tiles = std::vector<uint16_t>(ChunkTiles, EmptyTile);
+			uint32_t TileCount = 0;
+			bool Dirty = true;
+			//Built against the white placeholder, rebuilt once the tileset is loaded
+			bool WaitingTexture = false;
+
+			//Filled when the chunk is rebuilt
+			glm::vec2 Min = glm::vec2(0.0f);
+			glm::vec2 Max = glm::vec2(0.0f);
+			Shared<Texture> DrawTexture;
+			bool Opaque = false;
+			uint32_t InstanceCount = 0;
+			ChunkBuffer Buffer;
+		};
+
+		std::vector<TileChunk> m_Chunks;
+		std::unordered_map<uint64_t, uint32_t> m_ChunkLookup;
+		uint32_t m_TileCount = 0;
+
+		//Everything baked into the chunks besides the tiles, Renderer::DrawTilemap re-meshes them all when it changes
+		glm::mat4 m_Transform = glm::mat4(1.0f);
+		Shared<Texture> m_Tileset;
+		glm::vec2 m_TileSize = glm::vec2(0.0f);
+		glm::vec4 m_Color = glm::vec4(1.0f);
+		int m_Layer = 0;
+		bool SetBakeState(const glm::mat4& transform, const Shared<Texture>& tileset, const glm::vec2& tileSize, const glm::vec4& color, int layer);
+
+		TileChunk* FindChunk(const glm::ivec2& coord);
+		const TileChunk* FindChunk(const glm::ivec2& coord) const;
+		TileChunk& GetOrCreateChunk(const glm::ivec2& coord);
+		void ReleaseBuffers();
+
+		friend class Renderer;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "mpch.h"
+#include "Renderer/WorkerPool.h"
+
+namespace MoonEngine
+{
+	WorkerPool::WorkerPool(uint32_t workerCount)
+	{
+		for (uint32_t i = 0; i < workerCount; i++)
+			m_Workers.emplace_back(&WorkerPool::Loop, this);
+	}
+
+	void WorkerPool::Run(uint32_t count, const std::function<void(uint32_t)>& job)
+	{
+		//Not worth waking anyone for
+		if (m_Workers.empty() || count <= 1)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				job(i);
+			return;
+		}
+
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			m_Job = &job;
+			m_Count = count;
+			m_Next = 0;
+			m_Generation++;
+		}
+		m_JobReady.notify_all();
+
+		Drain();
+
+		//Workers that wake up after this find no job and go back to sleep
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_JobDone.wait(lock, [this] { return m_Active == 0; });
+		m_Job = nullptr;
+	}
+
+	void WorkerPool::Drain()
+	{
+		for (uint32_t i = m_Next++; i < m_Count; i = m_Next++)
+			(*m_Job)(i);
+	}
+
+	void WorkerPool::Loop()
+	{
+		uint64_t generation = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_JobReady.wait(lock, [&] { return m_Generation != generation || !m_Running; });
+
+				if (!m_Running)
+					return;
+
+				generation = m_Generation;
+				if (!m_Job)
+					continue;
+
+				m_Active++;
+			}
+
+			Drain();
+
+			{
+				std::scoped_lock<std::mutex> lock(m_Mutex);
+				m_Active--;
+			}
+			m_JobDone.notify_all();
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			m_Running = false;
+		}
+		m_JobReady.notify_all();
+
+		for (std::thread& worker : m_Workers)
+			worker.join();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace MoonEngine
+{
+	//Fixed set of threads that split an indexed job between them. Jobs must not touch the gl context
+	class WorkerPool
+	{
+	public:
+		explicit WorkerPool(uint32_t workerCount);
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+		~WorkerPool();
+
+		//Calls job once for every index below count, the calling thread helps out and returns when all of them ran
+		void Run(uint32_t count, const std::function<void(uint32_t)>& job);
+
+		//Threads taking part in a job, the caller included
+		uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size() + 1; }
+	private:
+		std::vector<std::thread> m_Workers;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobReady;
+		std::condition_variable m_JobDone;
+
+		const std::function<void(uint32_t)>* m_Job = nullptr;
+		uint32_t m_Count = 0;
+		std::atomic<uint32_t> m_Next = 0;
+		//Workers inside the current job, the job is only dropped once they all left
+		uint32_t m_Active = 0;
+		uint64_t m_Generation = 0;
+		bool m_Running = true;
+
+		void Loop();
+		void Drain();
+	};
+}
\ No newline at end of file
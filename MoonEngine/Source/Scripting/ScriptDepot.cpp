@@ -34,6 +34,7 @@ namespace MoonEngine
 		Entity newE = scene->DuplicateEntity(e);
 
 		newE.GetComponent<TransformComponent>().Position = *position;
+		newE.PatchComponent<TransformComponent>();
 		newE.GetComponent<PhysicsBodyComponent>().SetPosition(*position);
 
 		return newE.GetUUID();
@@ -76,7 +77,9 @@ namespace MoonEngine
 
 	void Transform_SetPosition(uint64_t id, glm::vec3* position)
 	{
-		GetEntity(id).GetComponent<TransformComponent>().Position = *position;
+		Entity entity = GetEntity(id);
+		entity.GetComponent<TransformComponent>().Position = *position;
+		entity.PatchComponent<TransformComponent>();
 	}
 
 #pragma endregion
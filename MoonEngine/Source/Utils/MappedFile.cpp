@@ -0,0 +1,88 @@
+#include "mpch.h"
+#include "Utils/MappedFile.h"
+
+#ifdef ENGINE_PLATFORM_WIN
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace MoonEngine
+{
+	bool MappedFile::Open(const std::filesystem::path& path, size_t maxSize)
+	{
+		Close();
+
+	#ifdef ENGINE_PLATFORM_WIN
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		//The view keeps the mapping and the file alive, both handles can go right away
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping)
+			return false;
+
+		size_t mappedSize = std::min((size_t)size.QuadPart, maxSize);
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, mappedSize);
+		CloseHandle(mapping);
+		if (!data)
+			return false;
+
+		m_Size = mappedSize;
+	#else
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat info = {};
+		if (fstat(file, &info) != 0 || info.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		size_t mappedSize = std::min((size_t)info.st_size, maxSize);
+		void* data = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		m_Size = mappedSize;
+	#endif
+
+		m_Data = (const uint8_t*)data;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (!m_Data)
+			return;
+
+	#ifdef ENGINE_PLATFORM_WIN
+		UnmapViewOfFile(m_Data);
+	#else
+		munmap((void*)m_Data, m_Size);
+	#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+}
\ No newline at end of file
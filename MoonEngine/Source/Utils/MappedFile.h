@@ -0,0 +1,24 @@
+#pragma once
+
+namespace MoonEngine
+{
+	//Read only view of a file, pages are read by the os as they are touched
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		//False when the file is missing, empty or can not be mapped. Only the first maxSize bytes are mapped when the file is bigger
+		bool Open(const std::filesystem::path& path, size_t maxSize = SIZE_MAX);
+		void Close();
+
+		const uint8_t* GetData() const { return m_Data; }
+		size_t GetSize() const { return m_Size; }
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+}
\ No newline at end of file
@@ -4,6 +4,11 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
 
+#if defined(_M_X64) || defined(__SSE2__)
+	#define ME_SSE2
+	#include <emmintrin.h>
+#endif
+
 namespace MoonEngine
 {
 	bool Maths::DecomposeTransform(const glm::mat4& transform, glm::vec3& translation, glm::vec3& rotation, glm::vec3& scale)
@@ -140,4 +145,66 @@ namespace MoonEngine
 	{
 		return from + time * (to - from);
 	}
+
+	void Maths::SinCos4(const float* angles, float* sines, float* cosines)
+	{
+#ifdef ME_SSE2
+		// Cephes sincosf, four lanes at a time
+		const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i two = _mm_set1_epi32(2);
+		const __m128i four = _mm_set1_epi32(4);
+
+		__m128 x = _mm_loadu_ps(angles);
+		__m128 signSin = _mm_and_ps(x, signMask);
+		x = _mm_andnot_ps(signMask, x);
+
+		//Octant of every angle, rounded up to an even number
+		__m128 y = _mm_mul_ps(x, _mm_set1_ps(1.27323954473516f));
+		__m128i octant = _mm_cvttps_epi32(y);
+		octant = _mm_add_epi32(octant, one);
+		octant = _mm_andnot_si128(one, octant);
+		y = _mm_cvtepi32_ps(octant);
+
+		signSin = _mm_xor_ps(signSin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, four), 29)));
+		__m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, two), four), 29));
+		__m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(octant, two), _mm_setzero_si128()));
+
+		//Extended precision reduction to [-pi/4, pi/4]
+		x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+		x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+		x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+		__m128 z = _mm_mul_ps(x, x);
+
+		__m128 cosPoly = _mm_set1_ps(2.443315711809948e-5f);
+		cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(-1.388731625493765e-3f));
+		cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(4.166664568298827e-2f));
+		cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+		cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+		cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+		__m128 sinPoly = _mm_set1_ps(-1.9515295891e-4f);
+		sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(8.3321608736e-3f));
+		sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(-1.6666654611e-1f));
+		sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+		//Octants 1 and 2 swap the two polynomials
+		__m128 sine = _mm_or_ps(_mm_and_ps(polyMask, sinPoly), _mm_andnot_ps(polyMask, cosPoly));
+		__m128 cosine = _mm_or_ps(_mm_and_ps(polyMask, cosPoly), _mm_andnot_ps(polyMask, sinPoly));
+
+		_mm_storeu_ps(sines, _mm_xor_ps(sine, signSin));
+		_mm_storeu_ps(cosines, _mm_xor_ps(cosine, signCos));
+#else
+		for (int i = 0; i < 4; i++)
+		{
+			sines[i] = std::sin(angles[i]);
+			cosines[i] = std::cos(angles[i]);
+		}
+#endif
+	}
+	uint32_t Maths::PackColor(const glm::vec4& color)
+	{
+		const glm::vec4& clamped = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+		return (uint32_t)clamped.r | ((uint32_t)clamped.g << 8) | ((uint32_t)clamped.b << 16) | ((uint32_t)clamped.a << 24);
+	}
 }
\ No newline at end of file
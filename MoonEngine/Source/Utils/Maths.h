@@ -15,5 +15,9 @@ namespace MoonEngine
 		static glm::vec2 Lerp(const glm::vec2& from, const glm::vec2& to, float time);
 		static glm::vec3 Lerp(const glm::vec3& from, const glm::vec3& to, float time);
 		static glm::vec4 Lerp(const glm::vec4& from, const glm::vec4& to, float time);
+		//Sine and cosine of four angles at once, uses sse when available
+		static void SinCos4(const float* angles, float* sines, float* cosines);
+		//Rgba8 with red in the lowest byte, the layout of a normalized unsigned byte vertex attribute
+		static uint32_t PackColor(const glm::vec4& color);
 	};
 }
\ No newline at end of file
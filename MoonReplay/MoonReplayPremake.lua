@@ -0,0 +1,47 @@
+project "MoonReplay"
+    kind "ConsoleApp"
+    language "C++"
+    staticruntime "off"
+
+    targetdir(dirTarget)
+    objdir(dirObj)
+
+    --Shaders and captures are looked up under the editor resources
+    debugdir "%{wks.location}/MoonEditor"
+
+    defines { "_CRT_SECURE_NO_WARNINGS", "GLFW_INCLUDE_NONE" }
+
+    files 
+    {
+        "**.h",
+        "**.cpp"
+    }
+
+    includedirs
+    {
+        "Source",
+        includeGLFW,
+        includeGlad,
+        includeEntt,
+        includeGlm,
+        includeMoonEngine,
+        includeSpdlog,
+    }
+
+    links
+    {
+        "MoonEngine"
+    }
+
+    filter "system:windows"
+        cppdialect "C++20"
+        systemversion "latest"
+        defines { "ENGINE_PLATFORM_WIN" }
+
+    filter "configurations:Debug"
+        defines { "ENGINE_DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "ENGINE_RELEASE" }
+        optimize "On"
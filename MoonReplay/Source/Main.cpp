@@ -0,0 +1,186 @@
+#include "mpch.h"
+
+#include <Engine/Components.h>
+#include <Renderer/FrameCapture.h>
+#include <Renderer/Renderer.h>
+
+#include <entt.hpp>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <random>
+
+//Submits count synthetic sprites every loop, once through DrawSprites and once per entity through DrawEntity
+static void BenchmarkSprites(uint32_t count, uint32_t loops)
+{
+	using namespace MoonEngine;
+
+	entt::registry registry;
+	Shared<Texture> texture = MakeShared<Texture>(32u, 32u);
+	std::mt19937 random(count);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	//Rotated around z so the bulk path goes through its 2D rotation, half of them textured and spread over a few layers
+	for (uint32_t i = 0; i < count; i++)
+	{
+		entt::entity entity = registry.create();
+		TransformComponent& transform = registry.emplace<TransformComponent>(entity);
+		transform.Position = { unit(random) * 100.0f, unit(random) * 100.0f, 0.0f };
+		transform.Rotation = { 0.0f, 0.0f, unit(random) * glm::pi<float>() };
+
+		SpriteComponent& sprite = registry.emplace<SpriteComponent>(entity);
+		sprite.Layer = (int)(i % 8);
+		if (i % 2 == 0)
+			sprite.SetTexture(texture);
+	}
+
+	auto view = registry.view<const TransformComponent, const SpriteComponent>();
+	auto run = [&](const std::function<void()>& submit)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t loop = 0; loop < loops; loop++)
+		{
+			Renderer::Begin(glm::mat4(1.0f), "Sprites");
+			submit();
+			Renderer::End();
+			Renderer::EndFrame();
+		}
+
+		float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return (float)count * loops / std::max(milliseconds, 0.001f);
+	};
+
+	float bulk = run([&] { Renderer::DrawSprites(view); });
+	float scalar = run([&]
+	{
+		view.each([](const TransformComponent& transform, const SpriteComponent& sprite) { Renderer::DrawEntity(transform, sprite); });
+	});
+	printf("%9u  %15.1f  %15.1f  %6.2fx\n", count, bulk, scalar, bulk / scalar);
+}
+
+//Replays a frame capture written by the editor and prints the renderer timings
+//Results go to stdout directly, the engine loggers are compiled out of release builds
+//Usage: MoonReplay <capture> [loops] [--gl] [--threads N | --sweep], the null backend is used unless --gl is given
+//--sweep replays once per write thread count from 1 to the core count, for the scaling of the quad writing
+//Usage: MoonReplay --sprites [loops] [--gl] [--threads N] compares bulk and per entity sprite submission without a capture
+int main(int argc, char** argv)
+{
+	using namespace MoonEngine;
+
+	Debug::Init();
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: MoonReplay <capture> [loops] [--gl] [--threads N | --sweep]\n");
+		fprintf(stderr, "       MoonReplay --sprites [loops] [--gl] [--threads N]\n");
+		return 1;
+	}
+
+	bool sprites = strcmp(argv[1], "--sprites") == 0;
+	std::string path = sprites ? "" : argv[1];
+	uint32_t loops = sprites ? 10 : 100;
+	//0 keeps the renderer default
+	uint32_t threads = 0;
+	bool gl = false;
+	bool sweep = false;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--gl") == 0)
+			gl = true;
+		else if (strcmp(argv[i], "--sweep") == 0)
+			sweep = true;
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			threads = (uint32_t)std::max(atoi(argv[++i]), 1);
+		else
+			loops = (uint32_t)std::max(atoi(argv[i]), 1);
+	}
+
+	//The gl backend only needs a context, the window is never shown
+	GLFWwindow* window = nullptr;
+	if (gl)
+	{
+		if (!glfwInit())
+		{
+			fprintf(stderr, "GLFW initialization failed!\n");
+			return 1;
+		}
+
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		window = glfwCreateWindow(64, 64, "MoonReplay", nullptr, nullptr);
+		if (!window)
+		{
+			fprintf(stderr, "Window creation failed!\n");
+			glfwTerminate();
+			return 1;
+		}
+
+		glfwMakeContextCurrent(window);
+		gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+	}
+
+	Renderer::Init(gl ? RendererBackend::OpenGL : RendererBackend::Null);
+
+	bool replayed = true;
+	if (sprites)
+	{
+		if (threads > 0)
+			Renderer::SetWriteThreads(threads);
+
+		//Whole frames are timed, Begin to EndFrame, so sorting and writing count for both paths
+		printf("Sprites per ms on the %s backend, %u write threads\n", gl ? "gl" : "null", Renderer::GetWriteThreads());
+		printf("  Sprites      DrawSprites       DrawEntity  Speedup\n");
+		for (uint32_t count : { 10000u, 100000u, 1000000u })
+			BenchmarkSprites(count, loops);
+	}
+	else if (sweep)
+	{
+		//Every count replays the same frames, only the writing time is expected to move
+		uint32_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+		printf("%s: write time per frame on the %s backend\n", path.c_str(), gl ? "gl" : "null");
+		printf("Threads  Writing ms  Speedup\n");
+
+		float singleWriteTime = 0.0f;
+		for (uint32_t count = 1; count <= cores && replayed; count++)
+		{
+			Renderer::SetWriteThreads(count);
+
+			FrameReplayStats stats;
+			replayed = FrameCapture::Replay(path, loops, stats);
+			if (!replayed)
+				break;
+
+			if (count == 1)
+				singleWriteTime = stats.WriteTime;
+			float speedup = stats.WriteTime > 0.0f ? singleWriteTime / stats.WriteTime : 0.0f;
+			printf("%7u  %10.3f  %6.2fx\n", Renderer::GetWriteThreads(), stats.WriteTime, speedup);
+		}
+	}
+	else
+	{
+		if (threads > 0)
+			Renderer::SetWriteThreads(threads);
+
+		FrameReplayStats stats;
+		replayed = FrameCapture::Replay(path, loops, stats);
+		if (replayed)
+		{
+			printf("%s: %u frames on the %s backend, %u write threads\n", path.c_str(), stats.Frames, gl ? "gl" : "null", Renderer::GetWriteThreads());
+			printf("Per frame Quads: %u Lines: %u Draw Calls: %u\n", stats.Quads, stats.Lines, stats.DrawCalls);
+			printf("Submit: %.3f ms End Frame: %.3f ms Writing: %.3f ms Gpu: %.3f ms\n", stats.SubmitTime, stats.EndFrameTime, stats.WriteTime, stats.GpuTime);
+		}
+	}
+
+	if (!replayed)
+		fprintf(stderr, "Could not replay %s\n", path.c_str());
+
+	Renderer::Terminate();
+
+	if (window)
+	{
+		glfwDestroyWindow(window);
+		glfwTerminate();
+	}
+
+	return replayed ? 0 : 1;
+}
\ No newline at end of file
@@ -50,3 +50,7 @@ group "MoonEditor"
     include "MoonEditor/MoonEditorPremake.lua"
     includeMoonEditor = "%{wks.location}/MoonEditor/Source"
 group ""
+
+group "Tools"
+    include "MoonReplay/MoonReplayPremake.lua"
+group ""